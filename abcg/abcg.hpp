@@ -16,6 +16,10 @@
 #include "abcgApplication.hpp"
 #include "abcgException.hpp"
 #include "abcgExternal.hpp"
+#include "abcgFrameStatistics.hpp"
+#include "abcgJobSystem.hpp"
+#include "abcgProfiler.hpp"
+#include "abcgStd140.hpp"
 #include "abcgTrackball.hpp"
 #include "abcgUtil.hpp"
 #include "abcgWindow.hpp"
@@ -12,9 +12,14 @@
 
 #include <SDL_image.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <ranges>
 #include <span>
 
 #include "abcgException.hpp"
+#include "abcgProfiler.hpp"
 #include "abcgWindow.hpp"
 
 #if defined(__EMSCRIPTEN__)
@@ -27,6 +32,38 @@
 
 #include "tiny_obj_loader.h"
 
+namespace {
+// Returns the ID of the window an event is targeted to, or zero if the event
+// is not specific to a window
+Uint32 getEventWindowID(SDL_Event const &event) {
+  switch (event.type) {
+  case SDL_WINDOWEVENT:
+    return event.window.windowID;
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+    return event.key.windowID;
+  case SDL_TEXTEDITING:
+    return event.edit.windowID;
+  case SDL_TEXTINPUT:
+    return event.text.windowID;
+  case SDL_MOUSEMOTION:
+    return event.motion.windowID;
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+    return event.button.windowID;
+  case SDL_MOUSEWHEEL:
+    return event.wheel.windowID;
+  case SDL_DROPFILE:
+  case SDL_DROPTEXT:
+  case SDL_DROPBEGIN:
+  case SDL_DROPCOMPLETE:
+    return event.drop.windowID;
+  default:
+    return 0;
+  }
+}
+} // namespace
+
 #if defined(__EMSCRIPTEN__)
 void abcg::mainLoopCallback(void *userData) {
   abcg::Application &app{*(static_cast<abcg::Application *>(userData))};
@@ -67,49 +104,278 @@ abcg::Application::Application([[maybe_unused]] int argc, char **argv) {
  * @brief Runs the application for the given window.
  *
  * Initializes the SDL library and its subsystems, initializes the window and
- * runs the event loop.
+ * runs the event loop. An abcg::JobSystem is created before the window is
+ * initialized, and is destroyed after the window is destroyed.
+ *
+ * If abcg::WindowSettings::headless is `true`, only the SDL video subsystem is
+ * initialized, and the SDL offscreen video driver is requested. If
+ * abcg::WindowSettings::maxFrames is greater than zero, the event loop ends
+ * after rendering that number of frames.
  *
  * @param window L-value reference to the window object.
  *
  * @throw abcg::SDLError if `SDL_Init` failed.
  * @throw abcg::SDLImageError if `IMG_Init` failed.
  */
-void abcg::Application::run(Window &window) {
-  if (Uint32 const subsystemMask{SDL_INIT_VIDEO | SDL_INIT_AUDIO |
-                                 SDL_INIT_GAMECONTROLLER};
-      SDL_Init(subsystemMask) != 0) {
+void abcg::Application::run(Window &window) { run(std::vector{&window}); }
+
+/**
+ * @brief Runs the application for the given windows.
+ *
+ * Same as abcg::Application::run(Window &), but for multiple windows driven
+ * by the same event loop. Windows are initialized in the given order and
+ * destroyed in reverse order. Events targeted to a window (e.g., keyboard and
+ * mouse events) are delivered only to that window. Each window has its own
+ * Dear ImGui context.
+ *
+ * The OpenGL contexts of abcg::OpenGLWindow objects share their objects
+ * (buffers, textures, shaders, programs), so resources created in one window
+ * can be used in the others. Container objects such as vertex array objects
+ * and framebuffer objects are not shared.
+ *
+ * The first window is the main window. Its settings determine whether the
+ * application is headless, the target frame rate of the event loop, and the
+ * maximum number of frames. The application ends when any window is closed.
+ *
+ * @param windows Pointers to the window objects.
+ *
+ * @throw abcg::RuntimeError if @a windows is empty, or if it has more than one
+ * window in WebAssembly builds.
+ * @throw abcg::SDLError if `SDL_Init` failed.
+ * @throw abcg::SDLImageError if `IMG_Init` failed.
+ *
+ * @remark If vertical synchronization is enabled, swapping the buffers of each
+ * window waits for the vertical retrace. Enable it only for the main window.
+ */
+void abcg::Application::run(std::vector<Window *> const &windows) {
+  if (windows.empty()) {
+    throw abcg::RuntimeError("No window to run");
+  }
+#if defined(__EMSCRIPTEN__)
+  if (windows.size() > 1) {
+    throw abcg::RuntimeError(
+        "Multiple windows are not supported in WebAssembly builds");
+  }
+#endif
+
+#if !defined(__EMSCRIPTEN__)
+  if (!m_applicationSettings.profilerTraceFilename.empty()) {
+    Profiler::setEnabled(true);
+  }
+#endif
+  Profiler::setThreadName("Main thread");
+
+  m_startupPhases.clear();
+  Timer startupTimer;
+  auto const markStartupPhase{[this, &startupTimer](std::string_view name) {
+    m_startupPhases.push_back(
+        {.name = std::string{name}, .duration = startupTimer.restart()});
+  }};
+
+  auto const headless{windows.front()->getWindowSettings().headless};
+
+  Uint32 subsystemMask{SDL_INIT_VIDEO};
+#if !defined(__EMSCRIPTEN__)
+  if (headless) {
+    // Render to an EGL pbuffer surface unless SDL_VIDEODRIVER is set
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+  }
+#endif
+  if (!headless && m_applicationSettings.initAudio) {
+    subsystemMask |= SDL_INIT_AUDIO;
+  }
+  if (!headless && m_applicationSettings.initGameController) {
+    subsystemMask |= SDL_INIT_GAMECONTROLLER;
+  }
+  if (SDL_Init(subsystemMask) != 0) {
     throw abcg::SDLError("SDL_Init failed");
   }
+  markStartupPhase("SDL_Init");
 
 #if !defined(__EMSCRIPTEN__)
-  // Load support for JPEG and PNG image formats
-  auto const imageFlags{IMG_INIT_JPG | IMG_INIT_PNG};
-  if (auto const initialized{IMG_Init(imageFlags)};
-      (initialized & imageFlags) != imageFlags) {
-    throw abcg::SDLImageError("IMG_Init failed");
+  if (m_applicationSettings.initImage) {
+    // Load support for JPEG and PNG image formats
+    auto const imageFlags{IMG_INIT_JPG | IMG_INIT_PNG};
+    if (auto const initialized{IMG_Init(imageFlags)};
+        (initialized & imageFlags) != imageFlags) {
+      throw abcg::SDLImageError("IMG_Init failed");
+    }
+    markStartupPhase("IMG_Init");
   }
 #endif
 
-  m_window = &window;
-  m_window->templateCreate();
+  m_jobSystem = std::make_unique<JobSystem>();
+  // Main-thread jobs submitted by workers wake up a main loop that is waiting
+  // for events
+  m_wakeEventType = SDL_RegisterEvents(1);
+  if (m_wakeEventType != static_cast<Uint32>(-1)) {
+    m_jobSystem->m_wakeMainThread = [type = m_wakeEventType] {
+      SDL_Event event{};
+      event.type = type;
+      SDL_PushEvent(&event);
+    };
+  }
+
+  m_windows = windows;
+  for (auto *window : m_windows) {
+    window->m_jobSystem = m_jobSystem.get();
+    window->templateCreate();
+    std::ranges::copy(window->m_startupPhases,
+                      std::back_inserter(m_startupPhases));
+    startupTimer.restart();
+  }
+
+  if (m_applicationSettings.printStartupPhases) {
+    auto total{0.0};
+    for (auto const &phase : m_startupPhases) {
+      fmt::print("{:.<24}: {:8.3f} ms\n", phase.name + ' ',
+                 phase.duration * 1000.0);
+      total += phase.duration;
+    }
+    fmt::print("{:.<24}: {:8.3f} ms\n", "Total startup time ",
+               total * 1000.0);
+  }
+
+  auto &mainWindow{*m_windows.front()};
+
+  if (!m_recordFilename.empty() || !m_replayFilename.empty()) {
+    std::vector<Uint32> windowIDs;
+    for (auto const *window : m_windows) {
+      windowIDs.push_back(window->getSDLWindowID());
+    }
+    if (!m_recordFilename.empty()) {
+      m_inputTraceWriter =
+          std::make_unique<InputTraceWriter>(m_recordFilename, windowIDs);
+    }
+    if (!m_replayFilename.empty()) {
+      m_inputTraceReader =
+          std::make_unique<InputTraceReader>(m_replayFilename, windowIDs);
+      for (auto *window : m_windows) {
+        window->m_replayDeltaTime = 0.0;
+      }
+    }
+  }
 
 #if defined(__EMSCRIPTEN__)
-  emscripten_set_main_loop_arg(mainLoopCallback, this, 0, true);
+  auto const fps{std::lround(mainWindow.getWindowSettings().targetFPS)};
+  emscripten_set_main_loop_arg(mainLoopCallback, this,
+                               gsl::narrow_cast<int>(fps), true);
 #else
+  Timer loopTime;
   auto done{false};
   while (!done) {
     mainLoopIterator(done);
   }
+
+  if (auto const frames{mainWindow.m_frameCount};
+      mainWindow.getWindowSettings().maxFrames > 0 && frames > 0) {
+    auto const seconds{loopTime.elapsed()};
+    fmt::print("Rendered {} frames in {:.3f} s ({:.3f} ms/frame)\n", frames,
+               seconds, 1000.0 * seconds / gsl::narrow_cast<double>(frames));
+  }
 #endif
 
-  m_window->templateDestroy();
+  for (auto *window : m_windows | std::views::reverse) {
+    window->templateDestroy();
+    window->m_jobSystem = nullptr;
+  }
+  m_windows.clear();
+  m_inputTraceWriter.reset();
+  m_inputTraceReader.reset();
+  m_jobSystem.reset();
 
 #if !defined(__EMSCRIPTEN__)
+  // SDL_image may initialize codecs on demand even without IMG_Init
   IMG_Quit();
+  if (auto const &filename{m_applicationSettings.profilerTraceFilename};
+      !filename.empty()) {
+    Profiler::writeChromeTrace(filename);
+    Profiler::setEnabled(false);
+  }
 #endif
   SDL_Quit();
 }
 
+/**
+ * @brief Records the input of the next run of the application to a file.
+ *
+ * The SDL events handled by the main loop and the delta time of each frame
+ * are written to a binary file that can be replayed with
+ * abcg::Application::replayInput.
+ *
+ * @param filename Path of the file to be created.
+ *
+ * @remark This must be called before abcg::Application::run.
+ *
+ * @sa abcg::InputTraceWriter
+ */
+void abcg::Application::recordInput(std::string_view filename) {
+  m_recordFilename = filename;
+}
+
+/**
+ * @brief Replays the input recorded with abcg::Application::recordInput in
+ * the next run of the application.
+ *
+ * The recorded events are handled and the windows are painted with the
+ * recorded delta times, as fast as possible and regardless of the frame rate
+ * settings. Live input is ignored, except for closing the application. The
+ * application ends when the end of the file is reached.
+ *
+ * Replaying the same file drives the windows with the same sequence of events
+ * and delta times, so that the performance of different builds can be
+ * compared on identical interaction traces.
+ *
+ * @param filename Path of the file to be replayed.
+ *
+ * @remark This must be called before abcg::Application::run. The application
+ * must create the same number of windows it created when recording.
+ *
+ * @sa abcg::InputTraceReader
+ */
+void abcg::Application::replayInput(std::string_view filename) {
+  m_replayFilename = filename;
+}
+
+/**
+ * @brief Returns the configuration settings of the application.
+ *
+ * @return Reference to the current abcg::ApplicationSettings object.
+ */
+abcg::ApplicationSettings const &
+abcg::Application::getApplicationSettings() const noexcept {
+  return m_applicationSettings;
+}
+
+/**
+ * @brief Sets the configuration settings of the application.
+ *
+ * @param applicationSettings Configuration settings.
+ *
+ * @remark This must be called before abcg::Application::run.
+ */
+void abcg::Application::setApplicationSettings(
+    ApplicationSettings const &applicationSettings) {
+  m_applicationSettings = applicationSettings;
+}
+
+/**
+ * @brief Returns the duration of each phase of the application startup.
+ *
+ * The phases are measured by abcg::Application::run from the initialization
+ * of SDL until the windows are created, including the window creation phases
+ * reported by abcg::Window::markStartupPhase.
+ *
+ * @return Startup phases, in the order they happened. Empty if the
+ * application has not run yet.
+ *
+ * @sa abcg::ApplicationSettings::printStartupPhases
+ */
+std::vector<abcg::StartupPhase> const &
+abcg::Application::getStartupPhases() const noexcept {
+  return m_startupPhases;
+}
+
 /**
  * @brief Returns the path to the application's assets directory, relative to
  * the directory the executable is launched from.
@@ -145,15 +411,148 @@ std::string const &abcg::Application::getBasePath() noexcept {
   return m_basePath;
 }
 
-void abcg::Application::mainLoopIterator([[maybe_unused]] bool &done) const {
+void abcg::Application::mainLoopIterator(bool &done) {
+  auto const replaying{m_inputTraceReader != nullptr};
+  auto const needsRepaint{[this] {
+    return std::ranges::any_of(
+        m_windows, [](auto const *window) { return window->needsRepaint(); });
+  }};
+  auto &mainWindow{*m_windows.front()};
+
+#if !defined(__EMSCRIPTEN__)
+  if (!replaying && needsRepaint()) {
+    mainWindow.waitForNextFrame();
+  }
+#endif
+
   SDL_Event event{};
+  m_events.clear();
+#if !defined(__EMSCRIPTEN__)
+  if (!replaying && !needsRepaint()) {
+    // Nothing to repaint. Block until an event arrives, but wake up at least
+    // every 100 ms so that the loop never blocks indefinitely
+    if (SDL_WaitEventTimeout(&event, 100) == 0) {
+      m_jobSystem->executeMainThreadJobs();
+      return;
+    }
+    // Don't count the idle time as frame time
+    for (auto *window : m_windows) {
+      window->m_deltaTime.restart();
+      window->m_presentTimer.restart();
+    }
+    pushEvent(event);
+  }
+#endif
   while (SDL_PollEvent(&event) != 0) {
+    pushEvent(event);
+  }
+
+  if (replaying) {
+    // Ignore live input, except for closing the application
+    auto const quit{std::ranges::any_of(m_events, [](auto const &liveEvent) {
+      return liveEvent.type == SDL_QUIT ||
+             (liveEvent.type == SDL_WINDOWEVENT &&
+              liveEvent.window.event == SDL_WINDOWEVENT_CLOSE);
+    })};
+    if (quit || !m_inputTraceReader->read(m_events, m_deltaTimes)) {
+      done = true;
+      return;
+    }
+  }
+
+  ABCG_PROFILE_SCOPE("Main loop");
+
+  for (auto const &pendingEvent : m_events) {
 #if !defined(__EMSCRIPTEN__)
-    if (event.type == SDL_QUIT) {
+    if (pendingEvent.type == SDL_QUIT) {
       done = true;
     }
 #endif
-    m_window->templateHandleEvent(event, done);
+    auto const windowID{getEventWindowID(pendingEvent)};
+    for (auto *window : m_windows) {
+      if (windowID == 0 || windowID == window->getSDLWindowID()) {
+        window->templateHandleEvent(pendingEvent, done);
+      }
+    }
+  }
+
+  {
+    ABCG_PROFILE_SCOPE("Main-thread jobs");
+    m_jobSystem->executeMainThreadJobs();
+  }
+
+  m_deltaTimes.resize(m_windows.size());
+  for (auto &&[window, deltaTime] : iter::zip(m_windows, m_deltaTimes)) {
+    if (replaying) {
+      if (deltaTime >= 0.0) {
+        window->m_replayDeltaTime = deltaTime;
+        window->templatePaint();
+      }
+    } else if (window->needsRepaint()) {
+      window->templatePaint();
+      deltaTime = window->getDeltaTime();
+    } else {
+      deltaTime = -1.0;
+    }
+  }
+
+  if (m_inputTraceWriter) {
+    m_inputTraceWriter->write(m_events, m_deltaTimes);
+  }
+
+  if (auto const maxFrames{mainWindow.getWindowSettings().maxFrames};
+      maxFrames > 0 && mainWindow.m_frameCount >= maxFrames) {
+    done = true;
+  }
+}
+
+// Appends an event to the list of events to be handled in this iteration of
+// the main loop, merging it with the previous event if possible
+void abcg::Application::pushEvent(SDL_Event const &event) {
+  // Wake-up events only interrupt the wait and are not handled by windows
+  if (event.type == m_wakeEventType) {
+    return;
+  }
+  if (m_events.empty() || m_events.back().type != event.type ||
+      (event.type != SDL_MOUSEMOTION && event.type != SDL_MOUSEWHEEL)) {
+    m_events.push_back(event);
+    return;
+  }
+
+  auto const windowID{getEventWindowID(event)};
+  auto const coalesce{std::ranges::any_of(m_windows, [windowID](auto *window) {
+    return window->getSDLWindowID() == windowID &&
+           window->getWindowSettings().coalesceInputEvents;
+  })};
+
+  auto &last{m_events.back()};
+  if (coalesce && event.type == SDL_MOUSEMOTION &&
+      last.motion.windowID == event.motion.windowID &&
+      last.motion.which == event.motion.which &&
+      last.motion.state == event.motion.state) {
+    last.motion.timestamp = event.motion.timestamp;
+    last.motion.x = event.motion.x;
+    last.motion.y = event.motion.y;
+    last.motion.xrel += event.motion.xrel;
+    last.motion.yrel += event.motion.yrel;
+    return;
+  }
+  if (coalesce && event.type == SDL_MOUSEWHEEL &&
+      last.wheel.windowID == event.wheel.windowID &&
+      last.wheel.which == event.wheel.which &&
+      last.wheel.direction == event.wheel.direction) {
+    last.wheel.timestamp = event.wheel.timestamp;
+    last.wheel.x += event.wheel.x;
+    last.wheel.y += event.wheel.y;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    last.wheel.preciseX += event.wheel.preciseX;
+    last.wheel.preciseY += event.wheel.preciseY;
+#endif
+#if SDL_VERSION_ATLEAST(2, 26, 0)
+    last.wheel.mouseX = event.wheel.mouseX;
+    last.wheel.mouseY = event.wheel.mouseY;
+#endif
+    return;
   }
-  m_window->templatePaint();
+  m_events.push_back(event);
 }
@@ -11,7 +11,14 @@
 #ifndef ABCG_APPLICATION_HPP_
 #define ABCG_APPLICATION_HPP_
 
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "abcgExternal.hpp"
+#include "abcgInputTrace.hpp"
+#include "abcgJobSystem.hpp"
 
 #define ABCG_VERSION_MAJOR 3
 #define ABCG_VERSION_MINOR 1
@@ -21,6 +28,8 @@
  * @brief Root namespace.
  */
 namespace abcg {
+struct ApplicationSettings;
+struct StartupPhase;
 class Application;
 class Window;
 #if defined(__EMSCRIPTEN__)
@@ -28,25 +37,98 @@ void mainLoopCallback(void *userData);
 #endif
 } // namespace abcg
 
+/**
+ * @brief Configuration settings of the application.
+ */
+struct abcg::ApplicationSettings {
+  /** @brief Whether to initialize the SDL audio subsystem at startup.
+   *
+   * If `false`, the subsystem can still be initialized later with
+   * `SDL_InitSubSystem(SDL_INIT_AUDIO)`.
+   */
+  bool initAudio{true};
+  /** @brief Whether to initialize the SDL game controller subsystem at
+   * startup.
+   *
+   * If `false`, the subsystem can still be initialized later with
+   * `SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER)`.
+   */
+  bool initGameController{true};
+  /** @brief Whether to load the JPEG and PNG libraries of SDL_image at
+   * startup.
+   *
+   * If `false`, the libraries are loaded when the first image is loaded.
+   */
+  bool initImage{true};
+  /** @brief Whether to print the duration of each startup phase to the
+   * standard output.
+   */
+  bool printStartupPhases{false};
+  /** @brief Path of a Chrome trace file to write the profiler zones to.
+   *
+   * If not empty, abcg::Profiler is enabled when the application starts, and
+   * the recorded zones are written to this file when the application exits.
+   *
+   * @remark Ignored in WebAssembly builds.
+   */
+  std::string profilerTraceFilename{};
+};
+
+/**
+ * @brief Duration of a phase of the application startup.
+ *
+ * @sa abcg::Application::getStartupPhases
+ */
+struct abcg::StartupPhase {
+  /** @brief Name of the phase. */
+  std::string name;
+  /** @brief Duration of the phase, in seconds. */
+  double duration{};
+};
+
 /**
  * @brief Manages the application's control flow.
  *
  * This is the class that starts an ABCg application, initializes the SDL
- * modules and enters the main event loop.
+ * modules and enters the main event loop of one or more windows.
  */
 class abcg::Application {
 public:
   Application(int argc, char **argv);
 
   void run(Window &window);
+  void run(std::vector<Window *> const &windows);
+
+  void recordInput(std::string_view filename);
+  void replayInput(std::string_view filename);
+
+  [[nodiscard]] ApplicationSettings const &
+  getApplicationSettings() const noexcept;
+  void setApplicationSettings(ApplicationSettings const &applicationSettings);
+  [[nodiscard]] std::vector<StartupPhase> const &
+  getStartupPhases() const noexcept;
 
   static std::string const &getAssetsPath() noexcept;
   static std::string const &getBasePath() noexcept;
 
 private:
-  void mainLoopIterator(bool &done) const;
+  void mainLoopIterator(bool &done);
+  void pushEvent(SDL_Event const &event);
+
+  ApplicationSettings m_applicationSettings;
+  std::vector<StartupPhase> m_startupPhases;
+
+  std::vector<Window *> m_windows;
+  std::vector<SDL_Event> m_events;
 
-  Window *m_window{};
+  std::string m_recordFilename;
+  std::string m_replayFilename;
+  std::unique_ptr<InputTraceWriter> m_inputTraceWriter;
+  std::unique_ptr<InputTraceReader> m_inputTraceReader;
+  std::vector<double> m_deltaTimes;
+  std::unique_ptr<JobSystem> m_jobSystem;
+  // Type of the event that wakes up the main loop for main-thread jobs
+  Uint32 m_wakeEventType{};
 
 #if defined(__EMSCRIPTEN__)
   friend void mainLoopCallback(void *userData);
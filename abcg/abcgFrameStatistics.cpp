@@ -0,0 +1,266 @@
+/**
+ * @file abcgFrameStatistics.cpp
+ * @brief Definition of abcg::FrameStatistics members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgFrameStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include <cppitertools/itertools.hpp>
+#include <fmt/core.h>
+#include <gsl/gsl>
+
+#include "abcgException.hpp"
+
+namespace {
+// Number of initial frames used only for setting up the moving average of
+// the present interval
+constexpr std::size_t warmupFrames{8};
+
+// Weight of the newest frame in the moving average of the present interval
+constexpr auto averageWeight{0.05};
+
+// Computes the percentiles with the nearest-rank method. Sorts the values
+abcg::FrameTimeSummary summarize(std::vector<double> &values) {
+  if (values.empty()) {
+    return {};
+  }
+  std::ranges::sort(values);
+  auto const percentile{[&values](double fraction) {
+    auto const rank{gsl::narrow_cast<std::size_t>(
+        std::ceil(fraction * gsl::narrow_cast<double>(values.size())))};
+    return values.at(std::clamp<std::size_t>(rank, 1, values.size()) - 1);
+  }};
+  return {.p50 = percentile(0.50),
+          .p95 = percentile(0.95),
+          .p99 = percentile(0.99),
+          .max = values.back()};
+}
+
+abcg::FrameStatisticsSummary
+summarize(std::span<abcg::FrameSample const> samples) {
+  std::vector<double> values;
+  values.reserve(samples.size());
+  auto const summarizeMember{[&samples, &values](auto member) {
+    values.clear();
+    for (auto const &sample : samples) {
+      // Frames without a GPU time have zero in that member
+      if (auto const value{sample.*member}; value > 0.0) {
+        values.push_back(value);
+      }
+    }
+    return summarize(values);
+  }};
+
+  return {
+      .frames = samples.size(),
+      .hitches = gsl::narrow_cast<std::size_t>(std::ranges::count_if(
+          samples, [](auto const &sample) { return sample.hitch; })),
+      .cpuTime = summarizeMember(&abcg::FrameSample::cpuTime),
+      .presentInterval = summarizeMember(&abcg::FrameSample::presentInterval),
+      .gpuTime = summarizeMember(&abcg::FrameSample::gpuTime)};
+}
+
+std::string toJSON(abcg::FrameTimeSummary const &summary) {
+  return fmt::format(R"({{"p50":{:.3f},"p95":{:.3f},"p99":{:.3f},)"
+                     R"("max":{:.3f}}})",
+                     summary.p50, summary.p95, summary.p99, summary.max);
+}
+} // namespace
+
+/**
+ * @brief Records the timing of a frame.
+ *
+ * This must be called from a single thread. The `hitch` member of @a sample is
+ * ignored and computed from its present interval.
+ *
+ * @param sample Timing of the frame.
+ */
+void abcg::FrameStatistics::record(FrameSample sample) {
+  auto const count{m_count.load(std::memory_order_relaxed)};
+
+  // The first frames set up the moving average and are never hitches
+  if (count < warmupFrames) {
+    sample.hitch = false;
+    m_averagePresentInterval =
+        std::lerp(m_averagePresentInterval, sample.presentInterval,
+                  1.0 / gsl::narrow_cast<double>(count + 1));
+  } else {
+    sample.hitch =
+        sample.presentInterval > hitchFactor * m_averagePresentInterval;
+    // Hitches do not raise the baseline
+    if (!sample.hitch) {
+      m_averagePresentInterval = std::lerp(
+          m_averagePresentInterval, sample.presentInterval, averageWeight);
+    }
+  }
+
+  auto &slot{m_samples.at(count % windowSize)};
+  slot.cpuTime.store(sample.cpuTime, std::memory_order_relaxed);
+  slot.presentInterval.store(sample.presentInterval,
+                             std::memory_order_relaxed);
+  slot.gpuTime.store(sample.gpuTime, std::memory_order_relaxed);
+  slot.hitch.store(sample.hitch, std::memory_order_relaxed);
+  if (sample.hitch) {
+    m_hitchCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  m_count.store(count + 1, std::memory_order_release);
+
+  if (m_keepHistory) {
+    m_history.push_back(sample);
+  }
+}
+
+/**
+ * @brief Discards all recorded frames.
+ *
+ * This must be called from the thread that records the frames.
+ */
+void abcg::FrameStatistics::clear() {
+  m_count.store(0, std::memory_order_release);
+  m_hitchCount.store(0, std::memory_order_relaxed);
+  m_averagePresentInterval = 0.0;
+  m_history.clear();
+}
+
+/**
+ * @brief Sets whether to keep all recorded frames.
+ *
+ * @param keepHistory If `true`, all frames recorded from now on are kept and
+ * can be written with abcg::FrameStatistics::writeFile. If `false`, only the
+ * most recent abcg::FrameStatistics::windowSize frames are kept.
+ */
+void abcg::FrameStatistics::setKeepHistory(bool keepHistory) {
+  m_keepHistory = keepHistory;
+  if (!keepHistory) {
+    m_history = {};
+  }
+}
+
+/**
+ * @brief Returns the number of frames recorded.
+ *
+ * @return Number of frames recorded since the creation or the last call to
+ * abcg::FrameStatistics::clear.
+ */
+std::size_t abcg::FrameStatistics::getFrameCount() const noexcept {
+  return m_count.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Returns the number of hitches recorded.
+ *
+ * @return Number of hitches since the creation or the last call to
+ * abcg::FrameStatistics::clear.
+ */
+std::size_t abcg::FrameStatistics::getHitchCount() const noexcept {
+  return m_hitchCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Computes the percentiles of the most recent frames.
+ *
+ * @return Summary of the most recent abcg::FrameStatistics::windowSize frames.
+ * Frames without a GPU time are not included in the GPU time percentiles.
+ */
+abcg::FrameStatisticsSummary abcg::FrameStatistics::getSummary() const {
+  return summarize(getRecentSamples());
+}
+
+/**
+ * @brief Returns the most recent frames.
+ *
+ * @param count Maximum number of frames to return. Values greater than
+ * abcg::FrameStatistics::windowSize are clamped.
+ *
+ * @return Most recent frames, from the oldest to the newest.
+ */
+std::vector<abcg::FrameSample>
+abcg::FrameStatistics::getRecentSamples(std::size_t count) const {
+  auto const total{m_count.load(std::memory_order_acquire)};
+  auto const numSamples{std::min({count, total, windowSize})};
+
+  std::vector<FrameSample> samples;
+  samples.reserve(numSamples);
+  for (auto index{total - numSamples}; index < total; ++index) {
+    auto const &slot{m_samples.at(index % windowSize)};
+    samples.push_back({
+        .cpuTime = slot.cpuTime.load(std::memory_order_relaxed),
+        .presentInterval = slot.presentInterval.load(std::memory_order_relaxed),
+        .gpuTime = slot.gpuTime.load(std::memory_order_relaxed),
+        .hitch = slot.hitch.load(std::memory_order_relaxed)});
+  }
+  return samples;
+}
+
+/**
+ * @brief Returns all frames recorded while keeping the history.
+ *
+ * This must be called from the thread that records the frames.
+ *
+ * @return Frames recorded since abcg::FrameStatistics::setKeepHistory was
+ * called with `true`.
+ */
+std::span<abcg::FrameSample const>
+abcg::FrameStatistics::getHistory() const noexcept {
+  return m_history;
+}
+
+/**
+ * @brief Writes the recorded frames to a file.
+ *
+ * If the file name ends with `.json`, the file is written in JSON format with
+ * the summary of the history and the timing of each of its frames. Otherwise,
+ * the timing of each frame of the history is written in CSV format.
+ *
+ * This must be called from the thread that records the frames.
+ *
+ * @param filename Path of the file to be created.
+ *
+ * @throw abcg::RuntimeError if the file cannot be created.
+ *
+ * @sa abcg::FrameStatistics::setKeepHistory.
+ */
+void abcg::FrameStatistics::writeFile(std::string const &filename) const {
+  std::ofstream stream(filename);
+  if (!stream) {
+    throw abcg::RuntimeError(
+        fmt::format("Failed to create frame statistics file {}", filename));
+  }
+
+  if (!filename.ends_with(".json")) {
+    stream << "frame,cpu_time_ms,present_interval_ms,gpu_time_ms,hitch\n";
+    for (auto const &&[index, sample] : iter::enumerate(m_history)) {
+      stream << fmt::format("{},{:.3f},{:.3f},{:.3f},{:d}\n", index,
+                            sample.cpuTime, sample.presentInterval,
+                            sample.gpuTime, sample.hitch ? 1 : 0);
+    }
+    return;
+  }
+
+  auto const summary{summarize(m_history)};
+  stream << fmt::format(R"({{"summary":{{"frames":{},"hitches":{},)"
+                        R"("cpuTime":{},"presentInterval":{},"gpuTime":{}}},)"
+                        "\n"
+                        R"("frames":[)",
+                        summary.frames, summary.hitches,
+                        toJSON(summary.cpuTime),
+                        toJSON(summary.presentInterval),
+                        toJSON(summary.gpuTime));
+  for (auto const &&[index, sample] : iter::enumerate(m_history)) {
+    stream << fmt::format(
+        R"({}{{"cpuTime":{:.3f},"presentInterval":{:.3f},"gpuTime":{:.3f},)"
+        R"("hitch":{}}})",
+        index == 0 ? "\n" : ",\n", sample.cpuTime, sample.presentInterval,
+        sample.gpuTime, sample.hitch);
+  }
+  stream << "]}\n";
+}
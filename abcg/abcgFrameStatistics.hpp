@@ -0,0 +1,142 @@
+/**
+ * @file abcgFrameStatistics.hpp
+ * @brief Header file of abcg::FrameStatistics.
+ *
+ * Declaration of abcg::FrameStatistics and related structures.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_FRAME_STATISTICS_HPP_
+#define ABCG_FRAME_STATISTICS_HPP_
+
+#include <array>
+#include <atomic>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace abcg {
+class FrameStatistics;
+struct FrameSample;
+struct FrameTimeSummary;
+struct FrameStatisticsSummary;
+} // namespace abcg
+
+/**
+ * @brief Timing of a single frame.
+ */
+struct abcg::FrameSample {
+  /** @brief CPU time spent updating and painting the frame, in
+   * milliseconds. */
+  double cpuTime{};
+  /** @brief Time between the end of the previous frame and the end of this
+   * frame, in milliseconds. */
+  double presentInterval{};
+  /** @brief GPU time of the most recent frame whose result was available when
+   * this frame was painted, in milliseconds, or zero if not available. */
+  double gpuTime{};
+  /** @brief Whether the frame is a hitch.
+   *
+   * @sa abcg::FrameStatistics::hitchFactor.
+   */
+  bool hitch{};
+};
+
+/**
+ * @brief Percentiles and maximum of a frame time metric, in milliseconds.
+ */
+struct abcg::FrameTimeSummary {
+  /** @brief Median. */
+  double p50{};
+  /** @brief 95th percentile. */
+  double p95{};
+  /** @brief 99th percentile. */
+  double p99{};
+  /** @brief Maximum value. */
+  double max{};
+};
+
+/**
+ * @brief Summary of the frame time metrics of recent frames.
+ *
+ * @sa abcg::FrameStatistics::getSummary.
+ */
+struct abcg::FrameStatisticsSummary {
+  /** @brief Number of frames summarized. */
+  std::size_t frames{};
+  /** @brief Number of hitches among the summarized frames. */
+  std::size_t hitches{};
+  /** @brief CPU time per frame. */
+  FrameTimeSummary cpuTime;
+  /** @brief Interval between presented frames. */
+  FrameTimeSummary presentInterval;
+  /** @brief GPU time per frame. */
+  FrameTimeSummary gpuTime;
+};
+
+/**
+ * @brief Records the timing of frames and computes rolling percentiles.
+ *
+ * Frames are recorded by a single thread (the main thread) into a ring of the
+ * most recent abcg::FrameStatistics::windowSize frames. Recording does not
+ * lock, and the ring can be read concurrently by other threads.
+ *
+ * A frame is counted as a hitch when its present interval is longer than
+ * abcg::FrameStatistics::hitchFactor times the moving average of the present
+ * interval of the previous frames.
+ *
+ * Optionally, all frames are kept so that they can be written to a CSV or JSON
+ * file.
+ *
+ * @sa abcg::Window::getFrameStatistics.
+ * @sa abcg::WindowSettings::frameStatisticsFilename.
+ */
+class abcg::FrameStatistics {
+public:
+  /** @brief Number of recent frames used for computing the percentiles. */
+  static constexpr std::size_t windowSize{512};
+  /** @brief Ratio between the present interval of a frame and the average
+   * present interval above which the frame is counted as a hitch. */
+  static constexpr double hitchFactor{2.0};
+
+  FrameStatistics() = default;
+  FrameStatistics(FrameStatistics const &) = delete;
+  FrameStatistics(FrameStatistics &&) = delete;
+  FrameStatistics &operator=(FrameStatistics const &) = delete;
+  FrameStatistics &operator=(FrameStatistics &&) = delete;
+  ~FrameStatistics() = default;
+
+  void record(FrameSample sample);
+  void clear();
+  void setKeepHistory(bool keepHistory);
+
+  [[nodiscard]] std::size_t getFrameCount() const noexcept;
+  [[nodiscard]] std::size_t getHitchCount() const noexcept;
+  [[nodiscard]] FrameStatisticsSummary getSummary() const;
+  [[nodiscard]] std::vector<FrameSample>
+  getRecentSamples(std::size_t count = windowSize) const;
+  [[nodiscard]] std::span<FrameSample const> getHistory() const noexcept;
+
+  void writeFile(std::string const &filename) const;
+
+private:
+  struct AtomicSample {
+    std::atomic<double> cpuTime;
+    std::atomic<double> presentInterval;
+    std::atomic<double> gpuTime;
+    std::atomic<bool> hitch;
+  };
+
+  std::array<AtomicSample, windowSize> m_samples{};
+  std::atomic<std::size_t> m_count{};
+  std::atomic<std::size_t> m_hitchCount{};
+  double m_averagePresentInterval{};
+  bool m_keepHistory{};
+  std::vector<FrameSample> m_history;
+};
+
+#endif
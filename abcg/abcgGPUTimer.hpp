@@ -0,0 +1,33 @@
+/**
+ * @file abcgGPUTimer.hpp
+ * @brief Declaration of a structure for reporting GPU times.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_GPU_TIMER_HPP_
+#define ABCG_GPU_TIMER_HPP_
+
+#include <string>
+
+namespace abcg {
+struct GPUPassTime;
+} // namespace abcg
+
+/**
+ * @brief GPU time of a named pass of a frame.
+ *
+ * @sa abcg::OpenGLGPUTimer::getPassTimes.
+ * @sa abcg::VulkanGPUTimer::getPassTimes.
+ */
+struct abcg::GPUPassTime {
+  /** @brief Name of the pass. */
+  std::string name;
+  /** @brief GPU time of the pass, in milliseconds. */
+  double milliseconds{};
+};
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * @file abcgInputTrace.cpp
+ * @brief Definition of abcg::InputTraceWriter and abcg::InputTraceReader
+ * members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgInputTrace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "abcgException.hpp"
+
+namespace {
+constexpr std::array<char, 8> traceMagic{'A', 'B', 'C', 'G',
+                                         'T', 'R', 'C', '1'};
+
+template <typename T, std::size_t Extent>
+void writeValues(std::ofstream &stream, std::span<T, Extent> values) {
+  stream.write(reinterpret_cast<char const *>(values.data()),
+               gsl::narrow<std::streamsize>(values.size_bytes()));
+}
+
+template <typename T> void writeValue(std::ofstream &stream, T const &value) {
+  writeValues(stream, std::span{&value, 1});
+}
+
+template <typename T, std::size_t Extent>
+[[nodiscard]] bool readValues(std::ifstream &stream,
+                              std::span<T, Extent> values) {
+  stream.read(reinterpret_cast<char *>(values.data()),
+              gsl::narrow<std::streamsize>(values.size_bytes()));
+  return stream.good();
+}
+
+template <typename T>
+[[nodiscard]] bool readValue(std::ifstream &stream, T &value) {
+  return readValues(stream, std::span{&value, 1});
+}
+
+// Returns whether an event can be safely written to a file (i.e., it does not
+// carry pointers)
+[[nodiscard]] bool isRecordable(SDL_Event const &event) {
+  switch (event.type) {
+  case SDL_QUIT:
+  case SDL_WINDOWEVENT:
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+  case SDL_TEXTEDITING:
+  case SDL_TEXTINPUT:
+  case SDL_MOUSEMOTION:
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+  case SDL_MOUSEWHEEL:
+  case SDL_CONTROLLERAXISMOTION:
+  case SDL_CONTROLLERBUTTONDOWN:
+  case SDL_CONTROLLERBUTTONUP:
+  case SDL_FINGERDOWN:
+  case SDL_FINGERUP:
+  case SDL_FINGERMOTION:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Returns a pointer to the window ID of a recordable event, or nullptr if the
+// event is not specific to a window
+[[nodiscard]] Uint32 *getWindowID(SDL_Event &event) {
+  switch (event.type) {
+  case SDL_WINDOWEVENT:
+    return &event.window.windowID;
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+    return &event.key.windowID;
+  case SDL_TEXTEDITING:
+    return &event.edit.windowID;
+  case SDL_TEXTINPUT:
+    return &event.text.windowID;
+  case SDL_MOUSEMOTION:
+    return &event.motion.windowID;
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+    return &event.button.windowID;
+  case SDL_MOUSEWHEEL:
+    return &event.wheel.windowID;
+  default:
+    return nullptr;
+  }
+}
+} // namespace
+
+/**
+ * @brief Creates a trace file and writes its header.
+ *
+ * @param filename Path of the file to be created.
+ * @param windowIDs SDL window IDs of the windows being recorded, in creation
+ * order.
+ *
+ * @throw abcg::RuntimeError if the file cannot be created.
+ */
+abcg::InputTraceWriter::InputTraceWriter(std::string const &filename,
+                                         std::span<Uint32 const> windowIDs)
+    : m_stream(filename, std::ios::binary), m_numWindows(windowIDs.size()) {
+  if (!m_stream) {
+    throw abcg::RuntimeError(
+        fmt::format("Failed to create input trace file {}", filename));
+  }
+
+  writeValues(m_stream, std::span{traceMagic});
+  writeValue(m_stream, gsl::narrow<Uint32>(sizeof(SDL_Event)));
+  writeValue(m_stream, gsl::narrow<Uint32>(windowIDs.size()));
+  writeValues(m_stream, windowIDs);
+}
+
+/**
+ * @brief Writes the events and delta times of one iteration of the main loop.
+ *
+ * @param events Events handled in the iteration. Events that cannot be
+ * recorded are skipped.
+ * @param deltaTimes Delta time of each window, in seconds, or a negative value
+ * if the window was not painted.
+ */
+void abcg::InputTraceWriter::write(std::span<SDL_Event const> events,
+                                   std::span<double const> deltaTimes) {
+  Expects(deltaTimes.size() == m_numWindows);
+
+  auto const numEvents{std::ranges::count_if(events, isRecordable)};
+  writeValue(m_stream, gsl::narrow<Uint32>(numEvents));
+  for (auto const &event : events) {
+    if (isRecordable(event)) {
+      writeValue(m_stream, event);
+    }
+  }
+  writeValues(m_stream, deltaTimes);
+}
+
+/**
+ * @brief Opens a trace file and reads its header.
+ *
+ * @param filename Path of the file to be read.
+ * @param windowIDs SDL window IDs of the current windows, in creation order.
+ *
+ * @throw abcg::RuntimeError if the file cannot be opened, if it is not a valid
+ * trace file, or if it was recorded with a different number of windows.
+ */
+abcg::InputTraceReader::InputTraceReader(std::string const &filename,
+                                         std::span<Uint32 const> windowIDs)
+    : m_stream(filename, std::ios::binary),
+      m_windowIDs(windowIDs.begin(), windowIDs.end()) {
+  if (!m_stream) {
+    throw abcg::RuntimeError(
+        fmt::format("Failed to open input trace file {}", filename));
+  }
+
+  std::array<char, traceMagic.size()> magic{};
+  Uint32 eventSize{};
+  Uint32 numWindows{};
+  if (!readValues(m_stream, std::span{magic}) || magic != traceMagic ||
+      !readValue(m_stream, eventSize) || eventSize != sizeof(SDL_Event) ||
+      !readValue(m_stream, numWindows)) {
+    throw abcg::RuntimeError(
+        fmt::format("Invalid input trace file {}", filename));
+  }
+  if (numWindows != windowIDs.size()) {
+    throw abcg::RuntimeError(
+        fmt::format("Input trace file {} was recorded with {} window(s)",
+                    filename, numWindows));
+  }
+
+  m_recordedWindowIDs.resize(numWindows);
+  if (!readValues(m_stream, std::span{m_recordedWindowIDs})) {
+    throw abcg::RuntimeError(
+        fmt::format("Invalid input trace file {}", filename));
+  }
+
+  auto const headerSize{m_stream.tellg()};
+  m_stream.seekg(0, std::ios::end);
+  m_fileSize = m_stream.tellg();
+  m_stream.seekg(headerSize);
+}
+
+/**
+ * @brief Reads the events and delta times of the next iteration of the main
+ * loop.
+ *
+ * @param events Vector that receives the events. The window IDs of the events
+ * are mapped to the IDs of the current windows.
+ * @param deltaTimes Vector that receives the delta time of each window.
+ *
+ * @return `false` if the end of the file was reached, `true` otherwise.
+ *
+ * @throw abcg::RuntimeError if the number of events of the record exceeds what
+ * is left in the file, e.g., if the file is corrupt.
+ */
+bool abcg::InputTraceReader::read(std::vector<SDL_Event> &events,
+                                  std::vector<double> &deltaTimes) {
+  Uint32 numEvents{};
+  if (!readValue(m_stream, numEvents)) {
+    return false;
+  }
+
+  // Check the count before allocating, as a corrupt count could be huge
+  auto const remainingSize{
+      gsl::narrow<std::uintmax_t>(m_fileSize - m_stream.tellg())};
+  auto const recordSize{std::uintmax_t{numEvents} * sizeof(SDL_Event) +
+                        m_windowIDs.size() * sizeof(double)};
+  if (recordSize > remainingSize) {
+    throw abcg::RuntimeError(fmt::format(
+        "Invalid input trace record: {} event(s) exceed the remaining {} bytes",
+        numEvents, remainingSize));
+  }
+
+  events.resize(numEvents);
+  deltaTimes.resize(m_windowIDs.size());
+  if (!readValues(m_stream, std::span{events}) ||
+      !readValues(m_stream, std::span{deltaTimes})) {
+    return false;
+  }
+
+  for (auto &event : events) {
+    if (auto *windowID{getWindowID(event)}) {
+      if (auto const iter{std::ranges::find(m_recordedWindowIDs, *windowID)};
+          iter != m_recordedWindowIDs.end()) {
+        *windowID =
+            m_windowIDs.at(gsl::narrow<std::size_t>(
+                std::distance(m_recordedWindowIDs.begin(), iter)));
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file abcgInputTrace.hpp
+ * @brief Header file of abcg::InputTraceWriter and abcg::InputTraceReader.
+ *
+ * Declaration of abcg::InputTraceWriter and abcg::InputTraceReader.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_INPUT_TRACE_HPP_
+#define ABCG_INPUT_TRACE_HPP_
+
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "abcgExternal.hpp"
+
+namespace abcg {
+class InputTraceWriter;
+class InputTraceReader;
+} // namespace abcg
+
+/**
+ * @brief Writes the SDL events and frame delta times of an application to a
+ * binary file.
+ *
+ * The file starts with a header that contains the SDL window IDs of the
+ * recorded windows, followed by one record per iteration of the main loop.
+ * Each record contains the events handled in the iteration and, for each
+ * window, the delta time of the frame painted in the iteration, or a negative
+ * value if the window was not painted.
+ *
+ * Events that carry pointers (e.g., `SDL_DROPFILE` and `SDL_USEREVENT`) are
+ * not recorded.
+ *
+ * @remark The file uses the native byte order and the memory layout of
+ * `SDL_Event`, so it should be replayed on the same platform and with the same
+ * SDL version it was recorded with.
+ */
+class abcg::InputTraceWriter {
+public:
+  InputTraceWriter(std::string const &filename,
+                   std::span<Uint32 const> windowIDs);
+
+  void write(std::span<SDL_Event const> events,
+             std::span<double const> deltaTimes);
+
+private:
+  std::ofstream m_stream;
+  std::size_t m_numWindows{};
+};
+
+/**
+ * @brief Reads the SDL events and frame delta times written by
+ * abcg::InputTraceWriter.
+ *
+ * The window IDs of the recorded events are mapped to the IDs of the current
+ * windows, in the order the windows were created.
+ */
+class abcg::InputTraceReader {
+public:
+  InputTraceReader(std::string const &filename,
+                   std::span<Uint32 const> windowIDs);
+
+  [[nodiscard]] bool read(std::vector<SDL_Event> &events,
+                          std::vector<double> &deltaTimes);
+
+private:
+  std::ifstream m_stream;
+  // Size of the file, used to validate the sizes of the records
+  std::streamoff m_fileSize{};
+  std::vector<Uint32> m_recordedWindowIDs;
+  std::vector<Uint32> m_windowIDs;
+};
+
+#endif
@@ -0,0 +1,293 @@
+/**
+ * @file abcgJobSystem.cpp
+ * @brief Definition of abcg::JobSystem and abcg::JobCounter members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgJobSystem.hpp"
+
+#include <iterator>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "abcgProfiler.hpp"
+
+namespace {
+// Job system and queue index of the worker running on the current thread
+thread_local abcg::JobSystem const *currentJobSystem{};
+thread_local std::size_t currentWorkerIndex{};
+} // namespace
+
+/**
+ * @brief Returns whether all jobs counted by this counter have finished.
+ *
+ * @return `true` if there are no pending jobs, `false` otherwise.
+ */
+bool abcg::JobCounter::isDone() const noexcept {
+  return m_pending.load(std::memory_order_acquire) == 0;
+}
+
+/**
+ * @brief Constructs a job system and starts its worker threads.
+ *
+ * The thread that constructs the job system is considered the main thread.
+ *
+ * @param numWorkers Number of worker threads. If zero, jobs are executed
+ * immediately on the thread that submits them.
+ */
+abcg::JobSystem::JobSystem(std::size_t numWorkers)
+    : m_queues(std::max<std::size_t>(numWorkers, 1)) {
+  m_workers.reserve(numWorkers);
+  for (std::size_t index{}; index < numWorkers; ++index) {
+    m_workers.emplace_back([this, index] { workerLoop(index); });
+  }
+}
+
+/**
+ * @brief Destroys the job system.
+ *
+ * Waits for the jobs that are being executed and joins the worker threads.
+ * Jobs that are still queued are discarded.
+ */
+abcg::JobSystem::~JobSystem() {
+  {
+    std::scoped_lock const lock{m_sleepMutex};
+    m_quit = true;
+  }
+  m_sleepCondition.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+}
+
+/**
+ * @brief Submits a job for execution on any worker thread.
+ *
+ * @param job Function to execute.
+ *
+ * @remark Exceptions thrown by jobs submitted without a counter are discarded.
+ */
+void abcg::JobSystem::run(Job job) { push({.job = std::move(job)}); }
+
+/**
+ * @brief Submits a job for execution on any worker thread and adds it to the
+ * group of jobs counted by a counter.
+ *
+ * @param job Function to execute.
+ * @param counter Counter of the group of jobs. Call abcg::JobSystem::wait
+ * with this counter to wait for the job to finish.
+ */
+void abcg::JobSystem::run(Job job, JobCounter &counter) {
+  counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+  push({.job = std::move(job), .counter = &counter});
+}
+
+/**
+ * @brief Submits a job for execution on the main thread.
+ *
+ * Use this to submit work that must be done on the thread that owns the
+ * graphics context, such as uploading data to OpenGL buffers. The job is
+ * executed by the main loop of abcg::Application before the next frame is
+ * painted, or earlier if the main thread is waiting in abcg::JobSystem::wait.
+ * If the main loop is idle waiting for events, it is woken up to execute the
+ * job.
+ *
+ * @param job Function to execute.
+ *
+ * @remark Do not wait in a worker for a counter of jobs that depend on a
+ * main-thread job while the main thread is waiting for that worker, as this
+ * leads to a deadlock.
+ */
+void abcg::JobSystem::runOnMainThread(Job job) {
+  {
+    std::scoped_lock const lock{m_mainThreadMutex};
+    m_mainThreadJobs.push_back(std::move(job));
+  }
+  if (m_wakeMainThread) {
+    m_wakeMainThread();
+  }
+}
+
+/**
+ * @brief Waits until all jobs counted by a counter have finished.
+ *
+ * Instead of blocking, the calling thread executes pending jobs while it
+ * waits. If called on the main thread, main-thread jobs are also executed.
+ *
+ * @param counter Counter of the group of jobs.
+ *
+ * @throw Rethrows the first exception thrown by the jobs of the group.
+ */
+void abcg::JobSystem::wait(JobCounter &counter) {
+  while (!counter.isDone()) {
+    if (isMainThread()) {
+      executeMainThreadJobs();
+    }
+    if (!tryExecuteOne()) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::scoped_lock const lock{counter.m_exceptionMutex};
+  if (auto exception{std::exchange(counter.m_exception, nullptr)}) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/**
+ * @brief Returns the number of worker threads.
+ *
+ * @return Number of worker threads, not counting the main thread.
+ */
+std::size_t abcg::JobSystem::getWorkerCount() const noexcept {
+  return m_workers.size();
+}
+
+/**
+ * @brief Returns whether the calling thread is the main thread.
+ *
+ * @return `true` if called from the thread that created the job system.
+ */
+bool abcg::JobSystem::isMainThread() const noexcept {
+  return std::this_thread::get_id() == m_mainThreadID;
+}
+
+/**
+ * @brief Returns the default number of worker threads.
+ *
+ * @return Number of hardware threads minus one (for the main thread), or zero
+ * in WebAssembly builds.
+ */
+std::size_t abcg::JobSystem::defaultWorkerCount() noexcept {
+#if defined(__EMSCRIPTEN__)
+  return 0;
+#else
+  auto const hardwareThreads{std::thread::hardware_concurrency()};
+  return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+#endif
+}
+
+void abcg::JobSystem::push(Task task) {
+  if (m_workers.empty()) {
+    execute(task);
+    return;
+  }
+
+  // Workers push to their own queue. Other threads distribute their jobs
+  // among the queues in a round-robin fashion
+  auto const index{currentJobSystem == this
+                       ? currentWorkerIndex
+                       : m_nextQueue.fetch_add(1, std::memory_order_relaxed) %
+                             m_queues.size()};
+  {
+    auto &queue{m_queues.at(index)};
+    std::scoped_lock const lock{queue.mutex};
+    // Count the task before it can be popped, so that the counter never
+    // wraps around when a worker pops it before it is counted
+    m_queuedTasks.fetch_add(1, std::memory_order_release);
+    queue.tasks.push_back(std::move(task));
+  }
+
+  {
+    // Lock to avoid missing the wake-up of a worker that is about to sleep
+    std::scoped_lock const lock{m_sleepMutex};
+  }
+  m_sleepCondition.notify_one();
+}
+
+bool abcg::JobSystem::tryExecuteOne() {
+  auto const isWorker{currentJobSystem == this};
+  auto const first{isWorker
+                       ? currentWorkerIndex
+                       : m_nextQueue.load(std::memory_order_relaxed) %
+                             m_queues.size()};
+
+  for (std::size_t offset{}; offset < m_queues.size(); ++offset) {
+    auto const index{(first + offset) % m_queues.size()};
+    auto &queue{m_queues.at(index)};
+
+    Task task;
+    {
+      std::scoped_lock const lock{queue.mutex};
+      if (queue.tasks.empty()) {
+        continue;
+      }
+      // Pop the most recent job from our own queue, and steal the oldest job
+      // from the other queues
+      if (isWorker && offset == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+    m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+
+    execute(task);
+    return true;
+  }
+  return false;
+}
+
+void abcg::JobSystem::execute(Task &task) {
+  try {
+    task.job();
+  } catch (...) {
+    if (task.counter != nullptr) {
+      std::scoped_lock const lock{task.counter->m_exceptionMutex};
+      if (!task.counter->m_exception) {
+        task.counter->m_exception = std::current_exception();
+      }
+    }
+  }
+
+  if (task.counter != nullptr) {
+    task.counter->m_pending.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+void abcg::JobSystem::workerLoop(std::size_t index) {
+  currentJobSystem = this;
+  currentWorkerIndex = index;
+  Profiler::setThreadName(fmt::format("Job worker {}", index));
+
+  while (true) {
+    if (tryExecuteOne()) {
+      continue;
+    }
+
+    std::unique_lock lock{m_sleepMutex};
+    m_sleepCondition.wait(lock, [this] {
+      return m_quit || m_queuedTasks.load(std::memory_order_acquire) > 0;
+    });
+    if (m_quit) {
+      return;
+    }
+  }
+}
+
+void abcg::JobSystem::executeMainThreadJobs() {
+  std::vector<Job> jobs;
+  {
+    std::scoped_lock const lock{m_mainThreadMutex};
+    jobs.swap(m_mainThreadJobs);
+  }
+  for (auto it{jobs.begin()}; it != jobs.end(); ++it) {
+    try {
+      (*it)();
+    } catch (...) {
+      // Keep the jobs that have not run for the next call
+      std::scoped_lock const lock{m_mainThreadMutex};
+      m_mainThreadJobs.insert(m_mainThreadJobs.begin(),
+                              std::make_move_iterator(std::next(it)),
+                              std::make_move_iterator(jobs.end()));
+      throw;
+    }
+  }
+}
@@ -0,0 +1,192 @@
+/**
+ * @file abcgJobSystem.hpp
+ * @brief Header file of abcg::JobSystem and abcg::JobCounter.
+ *
+ * Declaration of abcg::JobSystem and abcg::JobCounter.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_JOB_SYSTEM_HPP_
+#define ABCG_JOB_SYSTEM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace abcg {
+class Application;
+class JobCounter;
+class JobSystem;
+} // namespace abcg
+
+/**
+ * @brief Counts the jobs of a group that have not finished yet.
+ *
+ * Pass a counter to abcg::JobSystem::run to add a job to a group, and call
+ * abcg::JobSystem::wait to wait until all jobs of the group are finished.
+ * Counters can be used to express dependencies between jobs: a job that
+ * depends on a group of jobs can wait for the group's counter before doing its
+ * own work.
+ *
+ * @remark Objects of this type cannot be copied or moved, and must outlive the
+ * jobs they count.
+ */
+class abcg::JobCounter {
+public:
+  /**
+   * @brief Default constructor.
+   */
+  JobCounter() = default;
+  JobCounter(JobCounter const &) = delete;
+  JobCounter(JobCounter &&) = delete;
+  JobCounter &operator=(JobCounter const &) = delete;
+  JobCounter &operator=(JobCounter &&) = delete;
+  /**
+   * @brief Default destructor.
+   */
+  ~JobCounter() = default;
+
+  [[nodiscard]] bool isDone() const noexcept;
+
+private:
+  std::atomic<std::size_t> m_pending{};
+  std::mutex m_exceptionMutex;
+  std::exception_ptr m_exception;
+
+  friend JobSystem;
+};
+
+/**
+ * @brief Thread pool that executes jobs with work stealing.
+ *
+ * Each worker thread has its own double-ended queue of jobs. Jobs submitted
+ * from a worker are pushed to and popped from the back of the worker's queue,
+ * so that the most recent (and most likely cached) jobs are executed first.
+ * Idle workers steal jobs from the front of the queues of the other workers.
+ *
+ * Jobs that must run on the main thread, such as jobs that call OpenGL
+ * functions, can be submitted with abcg::JobSystem::runOnMainThread. These
+ * are executed by abcg::Application once per iteration of the main loop, and
+ * while the main thread waits for a counter.
+ *
+ * An instance of this class is owned by abcg::Application and can be accessed
+ * by the window through abcg::Window::getJobSystem.
+ *
+ * @remark Objects of this type cannot be copied or moved.
+ */
+class abcg::JobSystem {
+public:
+  /** @brief Type of the functions executed as jobs. */
+  using Job = std::function<void()>;
+
+  explicit JobSystem(std::size_t numWorkers = defaultWorkerCount());
+  JobSystem(JobSystem const &) = delete;
+  JobSystem(JobSystem &&) = delete;
+  JobSystem &operator=(JobSystem const &) = delete;
+  JobSystem &operator=(JobSystem &&) = delete;
+  ~JobSystem();
+
+  void run(Job job);
+  void run(Job job, JobCounter &counter);
+  void runOnMainThread(Job job);
+  void wait(JobCounter &counter);
+
+  template <typename T, typename Function>
+  void parallelFor(std::span<T> data, Function &&function,
+                   std::size_t batchSize = 0);
+
+  [[nodiscard]] std::size_t getWorkerCount() const noexcept;
+  [[nodiscard]] bool isMainThread() const noexcept;
+
+  [[nodiscard]] static std::size_t defaultWorkerCount() noexcept;
+
+private:
+  struct Task {
+    Job job;
+    JobCounter *counter{};
+  };
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void push(Task task);
+  [[nodiscard]] bool tryExecuteOne();
+  void execute(Task &task);
+  void workerLoop(std::size_t index);
+  void executeMainThreadJobs();
+
+  std::vector<WorkerQueue> m_queues;
+  std::vector<std::thread> m_workers;
+  std::thread::id m_mainThreadID{std::this_thread::get_id()};
+
+  std::atomic<std::size_t> m_queuedTasks{};
+  std::atomic<std::size_t> m_nextQueue{};
+  std::atomic<bool> m_quit{};
+  std::mutex m_sleepMutex;
+  std::condition_variable m_sleepCondition;
+
+  std::mutex m_mainThreadMutex;
+  std::vector<Job> m_mainThreadJobs;
+  // Called after a main-thread job is submitted, to wake up the main loop
+  std::function<void()> m_wakeMainThread;
+
+  friend Application;
+};
+
+/**
+ * @brief Calls a function for each element of a span, in parallel.
+ *
+ * The span is split into batches of contiguous elements, and each batch is
+ * submitted as a job. This function returns only after all elements are
+ * processed. While waiting, the calling thread also executes jobs.
+ *
+ * @param data Span of elements to process.
+ * @param function Function called with a reference to each element.
+ * @param batchSize Number of elements per job. If zero, the elements are split
+ * into about four batches per thread.
+ *
+ * @throw Rethrows the first exception thrown by @a function.
+ */
+template <typename T, typename Function>
+void abcg::JobSystem::parallelFor(std::span<T> data, Function &&function,
+                                  std::size_t batchSize) {
+  if (data.empty()) {
+    return;
+  }
+
+  if (batchSize == 0) {
+    auto const numBatches{4 * (getWorkerCount() + 1)};
+    batchSize = std::max<std::size_t>(1, data.size() / numBatches);
+  }
+
+  JobCounter counter;
+  for (std::size_t first{}; first < data.size(); first += batchSize) {
+    auto const count{std::min(batchSize, data.size() - first)};
+    auto const batch{data.subspan(first, count)};
+    run(
+        [batch, &function] {
+          for (auto &element : batch) {
+            function(element);
+          }
+        },
+        counter);
+  }
+  wait(counter);
+}
+
+#endif
@@ -14,8 +14,15 @@
 #define ABCG_OPENGL_HPP_
 
 #include "abcg.hpp"
+#include "abcgOpenGLBuildQueue.hpp"
+#include "abcgOpenGLGPUTimer.hpp"
 #include "abcgOpenGLImage.hpp"
+#include "abcgOpenGLProgramCache.hpp"
+#include "abcgOpenGLProgramReflection.hpp"
 #include "abcgOpenGLShader.hpp"
+#include "abcgOpenGLShaderHotReload.hpp"
+#include "abcgOpenGLStreamBuffer.hpp"
+#include "abcgOpenGLUniformBuffer.hpp"
 #include "abcgOpenGLWindow.hpp"
 
 #endif
@@ -0,0 +1,204 @@
+/**
+ * @file abcgOpenGLBuildQueue.cpp
+ * @brief Definition of abcg::OpenGLBuildQueue members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLBuildQueue.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <gsl/gsl>
+
+#include "abcgException.hpp"
+
+/**
+ * @brief Adds a program to the queue.
+ *
+ * The shaders are read and compiled in later calls to
+ * abcg::OpenGLBuildQueue::update.
+ *
+ * @param pathsOrSources Paths or source codes of the shaders to be compiled
+ * and linked to the program.
+ * @param throwOnError Whether abcg::OpenGLBuildQueue::update throws exceptions
+ * on compile/link errors of this program.
+ *
+ * @return Index of the build in the queue. This may be the index of a build
+ * previously released with abcg::OpenGLBuildQueue::release.
+ */
+std::size_t
+abcg::OpenGLBuildQueue::add(std::vector<ShaderSource> pathsOrSources,
+                            bool throwOnError) {
+  Build build;
+  build.sources = std::move(pathsOrSources);
+  build.throwOnError = throwOnError;
+  if (!m_releasedBuilds.empty()) {
+    auto const index{m_releasedBuilds.back()};
+    m_releasedBuilds.pop_back();
+    m_builds.at(index) = std::move(build);
+    return index;
+  }
+  m_builds.push_back(std::move(build));
+  return m_builds.size() - 1;
+}
+
+/**
+ * @brief Advances the builds of the queue.
+ *
+ * With parallel shader compilation, each pending build advances to its next
+ * step if the current one has finished, without waiting. Otherwise, only the
+ * first pending build advances, and its current step may block.
+ *
+ * @throw abcg::RuntimeError if a shader file could not be read, or if a build
+ * added with `throwOnError` set to `true` failed. The failed build is
+ * abcg::OpenGLBuildStatus::Failed and the other builds are left as they are,
+ * so the queue can still be updated.
+ */
+void abcg::OpenGLBuildQueue::update() {
+  if (!m_initialized) {
+    m_initialized = true;
+    m_parallel = isParallelShaderCompileSupported();
+    if (m_parallel) {
+      // Let the driver choose the number of threads
+      setMaxShaderCompilerThreads(0xFFFFFFFF);
+    }
+  }
+
+  for (auto &build : m_builds) {
+    if (build.stage == Stage::Done) {
+      continue;
+    }
+    advance(build, m_parallel);
+    if (!m_parallel) {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Releases a finished build so that its index can be reused.
+ *
+ * The program of a build that is abcg::OpenGLBuildStatus::Ready is not
+ * deleted, so get it with abcg::OpenGLBuildQueue::getProgram before releasing
+ * the build. The index must not be used after this call, until it is returned
+ * again by abcg::OpenGLBuildQueue::add.
+ *
+ * @param build Index returned by abcg::OpenGLBuildQueue::add.
+ *
+ * @throw abcg::RuntimeError if the build is abcg::OpenGLBuildStatus::Pending.
+ */
+void abcg::OpenGLBuildQueue::release(std::size_t build) {
+  auto &entry{m_builds.at(build)};
+  if (entry.status == OpenGLBuildStatus::Pending) {
+    throw abcg::RuntimeError("Cannot release a pending build");
+  }
+  entry = Build{.sources = {},
+                .shaders = {},
+                .program = 0,
+                .stage = Stage::Done,
+                .status = OpenGLBuildStatus::Failed,
+                .throwOnError = true};
+  m_releasedBuilds.push_back(build);
+}
+
+/**
+ * @brief Returns the status of a build.
+ *
+ * @param build Index returned by abcg::OpenGLBuildQueue::add.
+ *
+ * @return Status of the build.
+ */
+abcg::OpenGLBuildStatus
+abcg::OpenGLBuildQueue::getStatus(std::size_t build) const {
+  return m_builds.at(build).status;
+}
+
+/**
+ * @brief Returns the program of a build.
+ *
+ * @param build Index returned by abcg::OpenGLBuildQueue::add.
+ *
+ * @return ID of the program object if the build is
+ * abcg::OpenGLBuildStatus::Ready, or 0 otherwise.
+ */
+GLuint abcg::OpenGLBuildQueue::getProgram(std::size_t build) const {
+  auto const &entry{m_builds.at(build)};
+  return entry.status == OpenGLBuildStatus::Ready ? entry.program : 0;
+}
+
+/**
+ * @brief Returns the number of builds that are not finished.
+ *
+ * @return Number of abcg::OpenGLBuildStatus::Pending builds.
+ */
+std::size_t abcg::OpenGLBuildQueue::getNumPending() const noexcept {
+  return gsl::narrow_cast<std::size_t>(
+      std::ranges::count(m_builds, OpenGLBuildStatus::Pending, &Build::status));
+}
+
+/**
+ * @brief Returns whether all builds are finished.
+ *
+ * @return `true` if no build is abcg::OpenGLBuildStatus::Pending.
+ */
+bool abcg::OpenGLBuildQueue::isFinished() const noexcept {
+  return getNumPending() == 0;
+}
+
+void abcg::OpenGLBuildQueue::advance(Build &build, bool parallelCompile) {
+  // Each step marks the build as failed before calling functions that may
+  // throw, and restores it on success
+  switch (build.stage) {
+  case Stage::Queued: {
+    auto const sources{std::move(build.sources)};
+    build.stage = Stage::Done;
+    build.status = OpenGLBuildStatus::Failed;
+    build.shaders = triggerOpenGLShaderCompile(sources);
+    build.stage = Stage::Compiling;
+    build.status = OpenGLBuildStatus::Pending;
+    break;
+  }
+  case Stage::Compiling: {
+    auto const status{pollOpenGLShaderCompile(build.shaders, parallelCompile)};
+    if (status == OpenGLBuildStatus::Pending) {
+      break;
+    }
+    auto const shaders{std::move(build.shaders)};
+    build.stage = Stage::Done;
+    build.status = OpenGLBuildStatus::Failed;
+    if (status == OpenGLBuildStatus::Failed) {
+      // Prints the information log and deletes the shaders
+      static_cast<void>(checkOpenGLShaderCompile(shaders, build.throwOnError));
+      break;
+    }
+    build.program = triggerOpenGLShaderLink(shaders, build.throwOnError);
+    if (build.program != 0) {
+      build.stage = Stage::Linking;
+      build.status = OpenGLBuildStatus::Pending;
+    }
+    break;
+  }
+  case Stage::Linking: {
+    if (pollOpenGLShaderLink(build.program, parallelCompile) ==
+        OpenGLBuildStatus::Pending) {
+      break;
+    }
+    auto const program{std::exchange(build.program, 0U)};
+    build.stage = Stage::Done;
+    build.status = OpenGLBuildStatus::Failed;
+    // Prints the information log and deletes the program on error
+    if (checkOpenGLShaderLink(program, build.throwOnError)) {
+      build.program = program;
+      build.status = OpenGLBuildStatus::Ready;
+    }
+    break;
+  }
+  case Stage::Done:
+    break;
+  }
+}
@@ -0,0 +1,97 @@
+/**
+ * @file abcgOpenGLBuildQueue.hpp
+ * @brief Header file of abcg::OpenGLBuildQueue.
+ *
+ * Declaration of abcg::OpenGLBuildQueue.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_BUILD_QUEUE_HPP_
+#define ABCG_OPENGL_BUILD_QUEUE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "abcgOpenGLExternal.hpp"
+#include "abcgOpenGLShader.hpp"
+
+namespace abcg {
+class OpenGLBuildQueue;
+} // namespace abcg
+
+/**
+ * @brief Queue of programs built asynchronously over several frames.
+ *
+ * Programs added with abcg::OpenGLBuildQueue::add are compiled and linked by
+ * calls to abcg::OpenGLBuildQueue::update, typically one per frame, so that
+ * the application keeps rendering (e.g., a loading screen) while the programs
+ * are built.
+ *
+ * If parallel shader compilation is supported (see
+ * abcg::isParallelShaderCompileSupported), all programs are submitted to the
+ * driver at once and each update only polls their completion status, which
+ * never blocks. Otherwise, each update advances a single program by a single
+ * step (compile or link), which may block for the duration of that step.
+ *
+ * @code
+ * // In onCreate
+ * m_programID = m_buildQueue.add({{.source = "shader.vert",
+ *                                  .stage = abcg::ShaderStage::Vertex},
+ *                                 {.source = "shader.frag",
+ *                                  .stage = abcg::ShaderStage::Fragment}});
+ *
+ * // In onPaint
+ * if (!m_buildQueue.isFinished()) {
+ *   m_buildQueue.update();
+ *   // Render loading screen...
+ *   return;
+ * }
+ * auto const program{m_buildQueue.getProgram(m_programID)};
+ * @endcode
+ *
+ * The programs that are built with success are owned by the caller and must be
+ * deleted with `glDeleteProgram`. Finished builds can be released with
+ * abcg::OpenGLBuildQueue::release so that their indices are reused by later
+ * builds instead of growing the queue.
+ *
+ * @remark All functions must be called with the OpenGL context current.
+ */
+class abcg::OpenGLBuildQueue {
+public:
+  [[nodiscard]] std::size_t add(std::vector<ShaderSource> pathsOrSources,
+                                bool throwOnError = true);
+  void update();
+  void release(std::size_t build);
+
+  [[nodiscard]] OpenGLBuildStatus getStatus(std::size_t build) const;
+  [[nodiscard]] GLuint getProgram(std::size_t build) const;
+  [[nodiscard]] std::size_t getNumPending() const noexcept;
+  [[nodiscard]] bool isFinished() const noexcept;
+
+private:
+  enum class Stage : std::uint8_t { Queued, Compiling, Linking, Done };
+
+  struct Build {
+    std::vector<ShaderSource> sources;
+    std::vector<OpenGLShader> shaders;
+    GLuint program{};
+    Stage stage{Stage::Queued};
+    OpenGLBuildStatus status{OpenGLBuildStatus::Pending};
+    bool throwOnError{true};
+  };
+
+  static void advance(Build &build, bool parallelCompile);
+
+  std::vector<Build> m_builds;
+  // Indices of released builds, reused by add()
+  std::vector<std::size_t> m_releasedBuilds;
+  bool m_initialized{};
+  bool m_parallel{};
+};
+
+#endif
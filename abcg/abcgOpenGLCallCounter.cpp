@@ -0,0 +1,87 @@
+/**
+ * @file abcgOpenGLCallCounter.cpp
+ * @brief Definition of abcg::OpenGLCallCounter members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLCallCounter.hpp"
+
+#include <algorithm>
+
+namespace {
+// Head of the list of all counters. Counters are only added to the front of
+// the list and are never removed
+std::atomic<abcg::OpenGLCallCounter *> counters{};
+} // namespace
+
+/**
+ * @brief Constructs a counter and registers it for
+ * abcg::OpenGLCallCounter::takeSnapshot.
+ *
+ * The counter must have static storage duration.
+ *
+ * @param name Name of the OpenGL function. Must refer to a string literal.
+ * @param category Category of the OpenGL function.
+ */
+abcg::OpenGLCallCounter::OpenGLCallCounter(
+    std::string_view name, OpenGLCallCategory category) noexcept
+    : m_name{name}, m_category{category},
+      m_next{counters.load(std::memory_order_relaxed)} {
+  while (!counters.compare_exchange_weak(m_next, this,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+  }
+}
+
+/**
+ * @brief Returns the number of calls of each OpenGL function since the
+ * previous snapshot and resets the counters.
+ *
+ * @return Number of calls since the previous call to this function.
+ */
+abcg::OpenGLCallStatistics abcg::OpenGLCallCounter::takeSnapshot() {
+  OpenGLCallStatistics statistics;
+  for (auto *counter{counters.load(std::memory_order_acquire)};
+       counter != nullptr; counter = counter->m_next) {
+    auto const calls{counter->m_calls.exchange(0, std::memory_order_relaxed)};
+    auto const bytes{counter->m_bytes.exchange(0, std::memory_order_relaxed)};
+    if (calls == 0) {
+      continue;
+    }
+
+    statistics.calls += calls;
+    switch (counter->m_category) {
+    case OpenGLCallCategory::Draw:
+      statistics.draws += calls;
+      break;
+    case OpenGLCallCategory::Bind:
+      statistics.binds += calls;
+      break;
+    case OpenGLCallCategory::Uniform:
+      statistics.uniforms += calls;
+      break;
+    case OpenGLCallCategory::BufferUpload:
+      statistics.bufferUploads += calls;
+      statistics.bufferUploadBytes += bytes;
+      break;
+    case OpenGLCallCategory::State:
+      statistics.stateChanges += calls;
+      break;
+    case OpenGLCallCategory::Other:
+      break;
+    }
+    statistics.functions.push_back({.name = counter->m_name,
+                                    .category = counter->m_category,
+                                    .calls = calls,
+                                    .bytes = bytes});
+  }
+
+  std::ranges::sort(statistics.functions, [](auto const &lhs, auto const &rhs) {
+    return lhs.calls > rhs.calls;
+  });
+  return statistics;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file abcgOpenGLCallCounter.hpp
+ * @brief Header file of abcg::OpenGLCallCounter.
+ *
+ * Declaration of abcg::OpenGLCallCounter and related structures.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_CALL_COUNTER_HPP_
+#define ABCG_OPENGL_CALL_COUNTER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace abcg {
+enum class OpenGLCallCategory : std::uint8_t;
+class OpenGLCallCounter;
+struct OpenGLCallCount;
+struct OpenGLCallStatistics;
+} // namespace abcg
+
+/**
+ * @brief Category of an OpenGL function, used for grouping call counts.
+ */
+enum class abcg::OpenGLCallCategory : std::uint8_t {
+  /** @brief Draw calls, e.g., `glDrawArrays` and `glDrawElements`. */
+  Draw,
+  /** @brief Binding of objects, e.g., `glBindBuffer` and `glUseProgram`. */
+  Bind,
+  /** @brief Upload of uniform values, e.g., `glUniform4fv`. */
+  Uniform,
+  /** @brief Upload of buffer data, i.e., `glBufferData` and
+   * `glBufferSubData`. */
+  BufferUpload,
+  /** @brief Changes of fixed-function and vertex input state, e.g.,
+   * `glEnable`, `glBlendFunc` and `glVertexAttribPointer`. */
+  State,
+  /** @brief Any other function. */
+  Other
+};
+
+/**
+ * @brief Number of calls of an OpenGL function.
+ */
+struct abcg::OpenGLCallCount {
+  /** @brief Name of the function. */
+  std::string_view name;
+  /** @brief Category of the function. */
+  OpenGLCallCategory category{OpenGLCallCategory::Other};
+  /** @brief Number of calls. */
+  std::uint64_t calls{};
+  /** @brief Total number of bytes uploaded, for buffer uploads. */
+  std::uint64_t bytes{};
+};
+
+/**
+ * @brief Number of OpenGL calls issued since the previous snapshot.
+ *
+ * @sa abcg::OpenGLCallCounter::takeSnapshot.
+ */
+struct abcg::OpenGLCallStatistics {
+  /** @brief Total number of calls. */
+  std::uint64_t calls{};
+  /** @brief Number of draw calls. */
+  std::uint64_t draws{};
+  /** @brief Number of bind calls. */
+  std::uint64_t binds{};
+  /** @brief Number of uniform uploads. */
+  std::uint64_t uniforms{};
+  /** @brief Number of buffer uploads. */
+  std::uint64_t bufferUploads{};
+  /** @brief Total number of bytes of the buffer uploads. */
+  std::uint64_t bufferUploadBytes{};
+  /** @brief Number of state changes. */
+  std::uint64_t stateChanges{};
+  /** @brief Functions called at least once, sorted by decreasing number of
+   * calls. */
+  std::vector<OpenGLCallCount> functions;
+};
+
+/**
+ * @brief Counts the calls of an OpenGL function.
+ *
+ * When `ABCG_GL_CALL_COUNTERS` is defined (see the `ENABLE_GL_CALL_COUNTERS`
+ * CMake option), each OpenGL function wrapper defined in
+ * abcgOpenGLFunction.hpp has a static counter that is incremented on each
+ * call. Otherwise, the wrappers do not count calls and
+ * abcg::OpenGLCallCounter::takeSnapshot always returns empty statistics.
+ *
+ * Counters are global, i.e., they are shared among all windows and threads.
+ *
+ * @sa abcg::OpenGLWindow::getGLCallStatistics.
+ */
+class abcg::OpenGLCallCounter {
+public:
+  OpenGLCallCounter(std::string_view name,
+                    OpenGLCallCategory category) noexcept;
+  OpenGLCallCounter(OpenGLCallCounter const &) = delete;
+  OpenGLCallCounter(OpenGLCallCounter &&) = delete;
+  OpenGLCallCounter &operator=(OpenGLCallCounter const &) = delete;
+  OpenGLCallCounter &operator=(OpenGLCallCounter &&) = delete;
+  ~OpenGLCallCounter() = default;
+
+  /**
+   * @brief Counts a call.
+   *
+   * @param bytes Number of bytes uploaded by the call.
+   */
+  void add(std::int64_t bytes = 0) noexcept {
+    m_calls.fetch_add(1, std::memory_order_relaxed);
+    if (bytes > 0) {
+      m_bytes.fetch_add(static_cast<std::uint64_t>(bytes),
+                        std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] static OpenGLCallStatistics takeSnapshot();
+
+private:
+  std::string_view m_name;
+  OpenGLCallCategory m_category;
+  std::atomic<std::uint64_t> m_calls{};
+  std::atomic<std::uint64_t> m_bytes{};
+  OpenGLCallCounter *m_next{};
+};
+
+#if defined(ABCG_GL_CALL_COUNTERS)
+/**
+ * @brief Counts a call of an OpenGL function wrapper that uploads @a bytes
+ * bytes.
+ */
+#define ABCG_COUNT_GL_CALL_BYTES(function, category, bytes)                    \
+  static abcg::OpenGLCallCounter abcgCallCounter{                              \
+      #function, abcg::OpenGLCallCategory::category};                          \
+  abcgCallCounter.add(bytes)
+#else
+#define ABCG_COUNT_GL_CALL_BYTES(function, category, bytes)                    \
+  static_cast<void>(0)
+#endif
+
+/**
+ * @brief Counts a call of an OpenGL function wrapper.
+ */
+#define ABCG_COUNT_GL_CALL(function, category)                                 \
+  ABCG_COUNT_GL_CALL_BYTES(function, category, 0)
+
+#endif
@@ -12,6 +12,40 @@
 #include "abcgOpenGLError.hpp"
 
 #if !defined(NDEBUG) && !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+#include <optional>
+#include <string>
+
+#include <fmt/core.h>
+
+namespace {
+// Error reported by the KHR_debug message callback on this thread
+struct GLDebugError {
+  std::string message;
+  // Location of the function wrapper that generated the error, if known
+  std::optional<abcg::source_location> sourceLocation;
+};
+
+thread_local GLDebugError pendingError;
+
+void GLAPIENTRY debugMessageCallback(
+    [[maybe_unused]] GLenum source, GLenum type, [[maybe_unused]] GLuint id,
+    [[maybe_unused]] GLenum severity, GLsizei length, GLchar const *message,
+    [[maybe_unused]] void const *userParam) {
+  // Keep only the first error until it is thrown
+  if (type != GL_DEBUG_TYPE_ERROR || abcg::glDebugState.errorPending) {
+    return;
+  }
+  pendingError.message =
+      length < 0 ? std::string{message}
+                 : std::string{message, static_cast<std::size_t>(length)};
+  pendingError.sourceLocation.reset();
+  if (abcg::glDebugState.sourceLocation != nullptr) {
+    pendingError.sourceLocation = *abcg::glDebugState.sourceLocation;
+  }
+  abcg::glDebugState.errorPending = true;
+}
+} // namespace
+
 /**
  * @brief Checks OpenGL error status and throws on error with a log message.
  *
@@ -29,4 +63,115 @@ void abcg::checkGLError(source_location const &sourceLocation,
     throw abcg::OpenGLError(appendString, status, sourceLocation);
   }
 }
+
+/**
+ * @brief Throws the error reported by the `KHR_debug` message callback.
+ *
+ * @param sourceLocation Information about the source code, used for logging
+ * if the error was generated outside a function wrapper, e.g., by a function
+ * of the global namespace.
+ * @param appendString A string to be appended to "OpenGL error " in the
+ * exception explanatory string.
+ *
+ * @throw abcg::Exception::OpenGLError.
+ */
+void abcg::throwGLDebugError(source_location const &sourceLocation,
+                             std::string_view const appendString) {
+  glDebugState.errorPending = false;
+  auto const location{pendingError.sourceLocation.value_or(sourceLocation)};
+  auto const what{pendingError.sourceLocation.has_value()
+                      ? fmt::format("reported by KHR_debug: {}",
+                                    pendingError.message)
+                      : fmt::format("{}, reported by KHR_debug: {}",
+                                    appendString, pendingError.message)};
+  // The error flag is still set, so this is the only glGetError round-trip
+  throw abcg::OpenGLError(what, glGetError(), location);
+}
+
+/**
+ * @brief Reports OpenGL errors of the calling thread through the `KHR_debug`
+ * message callback instead of `glGetError`.
+ *
+ * Enables synchronous debug output in the current context and installs a
+ * message callback that records errors, which are then thrown by the function
+ * wrappers without calling `glGetError` before and after each call.
+ *
+ * The message callback is installed in the current context, but
+ * abcg::glDebugState is per thread. If the calling thread switches between
+ * contexts, set abcg::GLDebugState::enabled each time a context is made
+ * current, as abcg::OpenGLWindow does for the contexts of its windows.
+ *
+ * @return `true` if errors are reported by the message callback, `false` if
+ * `KHR_debug` is not supported by the current context.
+ */
+bool abcg::enableGLDebugOutput() {
+  if (GLEW_VERSION_4_3 == GL_FALSE && GLEW_KHR_debug == GL_FALSE) {
+    glDebugState.enabled = false;
+    return false;
+  }
+
+  glEnable(GL_DEBUG_OUTPUT);
+  // Synchronous output calls the callback in the thread of the failed call,
+  // before it returns, so the error can be attributed to it
+  glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr,
+                        GL_FALSE);
+  glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0,
+                        nullptr, GL_TRUE);
+  glDebugMessageCallback(debugMessageCallback, nullptr);
+
+  glDebugState.enabled = true;
+  return true;
+}
+#elif defined(ABCG_GL_SAMPLED_ERROR_CHECKS) && !defined(__EMSCRIPTEN__) &&     \
+    !defined(__APPLE__)
+#include <string>
+#include <utility>
+
+#include <fmt/core.h>
+
+/**
+ * @brief Checks OpenGL error status and throws on error with the source
+ * locations of the calls made since the previous check.
+ *
+ * This is called by the function wrappers once every abcg::GLCallRing::size
+ * calls, and by abcg::OpenGLWindow at the end of each frame. Since the error
+ * may have been generated by any of the calls made since the previous check,
+ * all of them are reported as candidates.
+ *
+ * @throw abcg::Exception::OpenGLError.
+ */
+void abcg::checkSampledGLErrors() {
+  auto &ring{glCallRing};
+  auto const numCalls{std::exchange(ring.numCalls, 0)};
+
+  auto const status{glGetError()};
+  if (status == GL_NO_ERROR) {
+    return;
+  }
+
+  // List the candidate call sites, oldest first, merging consecutive calls
+  // from the same site
+  std::string what{fmt::format("in one of the last {} calls:", numCalls)};
+  for (std::size_t index{}; index < numCalls;) {
+    auto const &location{ring.sourceLocations.at(index)};
+    std::size_t repeats{1};
+    while (index + repeats < numCalls) {
+      auto const &next{ring.sourceLocations.at(index + repeats)};
+      if (next.line() != location.line() ||
+          next.column() != location.column() ||
+          std::string_view{next.file_name()} != location.file_name()) {
+        break;
+      }
+      ++repeats;
+    }
+    what += fmt::format("\n  {}:{}, {}", location.file_name(), location.line(),
+                        location.function_name());
+    if (repeats > 1) {
+      what += fmt::format(" (x{})", repeats);
+    }
+    index += repeats;
+  }
+  throw abcg::OpenGLError(what, status);
+}
 #endif
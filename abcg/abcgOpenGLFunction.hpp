@@ -3,7 +3,12 @@
  * @brief Declaration of OpenGL-related error checking functions.
  *
  * Error checking wrappers for OpenGL functions are defined here as inline
- * functions.
+ * functions. In release builds, if `ABCG_GL_SAMPLED_ERROR_CHECKS` is defined,
+ * errors are checked only once every few calls (see
+ * abcg::checkSampledGLErrors). If `ABCG_GL_CALL_COUNTERS` is defined, the
+ * wrappers also count their calls (see abcg::OpenGLCallCounter). If
+ * `ABCG_GL_STATE_CACHE` is defined, redundant binds are skipped (see
+ * abcg::OpenGLStateCache).
  *
  * This file is part of ABCg (https://github.com/hbatagelo/abcg).
  *
@@ -14,7 +19,8 @@
 #ifndef ABCG_OPENGL_FUNCTION_HPP_
 #define ABCG_OPENGL_FUNCTION_HPP_
 
-#if !defined(NDEBUG) && !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+#if (!defined(NDEBUG) || defined(ABCG_GL_SAMPLED_ERROR_CHECKS)) &&             \
+    !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
 #if __clang__
 #include <experimental/source_location>
 namespace abcg {
@@ -28,10 +34,14 @@ using source_location = std::source_location;
 #endif
 #endif
 
+#include <array>
+#include <cstddef>
 #include <string_view>
 #include <type_traits>
 
+#include "abcgOpenGLCallCounter.hpp"
 #include "abcgOpenGLExternal.hpp"
+#include "abcgOpenGLStateCache.hpp"
 
 #if defined(_MSC_VER)
 // Disable "unreachable code" warnings for the case callGl is not specialized
@@ -43,12 +53,118 @@ using source_location = std::source_location;
 namespace abcg {
 #if !defined(NDEBUG) && !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
 
+/**
+ * @brief Per-thread state of the OpenGL error reporting.
+ *
+ * @sa abcg::enableGLDebugOutput.
+ */
+struct GLDebugState {
+  /** @brief Whether errors are reported by the `KHR_debug` message callback
+   * instead of being checked with `glGetError`. */
+  bool enabled{};
+  /** @brief Whether the callback has reported an error that has not been
+   * thrown yet. */
+  bool errorPending{};
+  /** @brief Source location of the function wrapper being called, if any. */
+  source_location const *sourceLocation{};
+};
+
+inline thread_local GLDebugState glDebugState{};
+
 void checkGLError(source_location const &sourceLocation,
                   std::string_view appendString);
+void throwGLDebugError(source_location const &sourceLocation,
+                       std::string_view appendString);
+bool enableGLDebugOutput();
+
+/**
+ * @brief Checks for OpenGL errors.
+ *
+ * If errors are reported by the `KHR_debug` message callback, this only throws
+ * the error reported by the callback, if any, without calling `glGetError`.
+ * Otherwise, this calls abcg::checkGLError.
+ *
+ * @param sourceLocation Information about the source code, used for logging.
+ * @param appendString A string to be appended to "OpenGL error " in the
+ * exception explanatory string.
+ *
+ * @throw abcg::Exception::OpenGLError.
+ */
+inline void checkGLCall(source_location const &sourceLocation,
+                        std::string_view appendString) {
+  if (!glDebugState.enabled) {
+    checkGLError(sourceLocation, appendString);
+  } else if (glDebugState.errorPending) {
+    throwGLDebugError(sourceLocation, appendString);
+  }
+}
 
 /**
  * @brief Checks for OpenGL errors before and after a function call.
  *
+ * While the function is called, its source location is stored in
+ * abcg::glDebugState so that errors reported by the `KHR_debug` message
+ * callback are attributed to it.
+ *
+ * @tparam TFun Function typename.
+ * @tparam TArgs Variadic arguments typename.
+ *
+ * @param sourceLocation Information about the source code, used for logging.
+ * @param function Function to be called.
+ * @param args Variadic template arguments for the function.
+ *
+ * @return Value returned from function, or void.
+ */
+template <typename TFun, typename... TArgs>
+auto callGL(source_location const &sourceLocation, TFun &&function,
+            TArgs &&...args) {
+  checkGLCall(sourceLocation, "BEFORE function call");
+  glDebugState.sourceLocation = &sourceLocation;
+  if constexpr (!std::is_void_v<std::invoke_result_t<TFun, TArgs...>>) {
+    // Specialization for functions that do not return void
+    auto &&res{std::forward<TFun>(function)(std::forward<TArgs>(args)...)};
+    glDebugState.sourceLocation = nullptr;
+    checkGLCall(sourceLocation, "AFTER function call");
+    return res;
+  }
+  // Specialization for functions that return void
+  std::forward<TFun>(function)(std::forward<TArgs>(args)...);
+  glDebugState.sourceLocation = nullptr;
+  checkGLCall(sourceLocation, "AFTER function call");
+}
+
+#elif defined(ABCG_GL_SAMPLED_ERROR_CHECKS) && !defined(__EMSCRIPTEN__) &&     \
+    !defined(__APPLE__)
+
+/**
+ * @brief Source locations of the most recent OpenGL function wrapper calls of
+ * a thread.
+ *
+ * @sa abcg::checkSampledGLErrors.
+ */
+struct GLCallRing {
+  /** @brief Number of calls between two calls to `glGetError`, which is also
+   * the number of source locations kept. */
+  static constexpr std::size_t size{64};
+
+  /** @brief Source locations of the calls, indexed by call number modulo
+   * abcg::GLCallRing::size. */
+  std::array<source_location, size> sourceLocations{};
+  /** @brief Number of calls since the last check. */
+  std::size_t numCalls{};
+};
+
+inline thread_local GLCallRing glCallRing{};
+
+void checkSampledGLErrors();
+
+/**
+ * @brief Calls a function with given arguments and records its source
+ * location for the sampled error checks.
+ *
+ * Errors are checked with `glGetError` only once every
+ * abcg::GLCallRing::size calls, and by abcg::checkSampledGLErrors.
+ *
  * @tparam TFun Function typename.
  * @tparam TArgs Variadic arguments typename.
  *
@@ -61,16 +177,22 @@ void checkGLError(source_location const &sourceLocation,
 template <typename TFun, typename... TArgs>
 auto callGL(source_location const &sourceLocation, TFun &&function,
             TArgs &&...args) {
-  checkGLError(sourceLocation, "BEFORE function call");
+  auto &ring{glCallRing};
+  ring.sourceLocations.at(ring.numCalls) = sourceLocation;
+  auto const check{++ring.numCalls == GLCallRing::size};
   if constexpr (!std::is_void_v<std::invoke_result_t<TFun, TArgs...>>) {
     // Specialization for functions that do not return void
     auto &&res{std::forward<TFun>(function)(std::forward<TArgs>(args)...)};
-    checkGLError(sourceLocation, "AFTER function call");
+    if (check) {
+      checkSampledGLErrors();
+    }
     return res;
   }
   // Specialization for functions that return void
   std::forward<TFun>(function)(std::forward<TArgs>(args)...);
-  checkGLError(sourceLocation, "AFTER function call");
+  if (check) {
+    checkSampledGLErrors();
+  }
 }
 
 #else
@@ -112,110 +234,147 @@ auto callGL([[maybe_unused]] source_location, TFun &&function,
 inline void glActiveTexture(
     GLenum texture,
     source_location const &sourceLocation = source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  if (glStateCache.activeTexture(texture)) {
+    return;
+  }
+#endif
+  ABCG_COUNT_GL_CALL(glActiveTexture, Bind);
   callGL(sourceLocation, ::glActiveTexture, texture);
 }
 inline void glAttachShader(
     GLuint program, GLuint shader,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glAttachShader, Other);
   callGL(sourceLocation, ::glAttachShader, program, shader);
 }
 inline void glBindAttribLocation(
     GLuint program, GLuint index, GLchar const *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBindAttribLocation, Other);
   callGL(sourceLocation, ::glBindAttribLocation, program, index, name);
 }
 inline void glBindBuffer(
     GLenum target, GLuint buffer,
     source_location const &sourceLocation = source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  if (glStateCache.bindBuffer(target, buffer)) {
+    return;
+  }
+#endif
+  ABCG_COUNT_GL_CALL(glBindBuffer, Bind);
   callGL(sourceLocation, ::glBindBuffer, target, buffer);
 }
 inline void glBindFramebuffer(
     GLenum target, GLuint framebuffer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBindFramebuffer, Bind);
   callGL(sourceLocation, ::glBindFramebuffer, target, framebuffer);
 }
 inline void glBindRenderbuffer(
     GLenum target, GLuint renderbuffer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBindRenderbuffer, Bind);
   callGL(sourceLocation, ::glBindRenderbuffer, target, renderbuffer);
 }
 inline void glBindTexture(
     GLenum target, GLuint texture,
     source_location const &sourceLocation = source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  if (glStateCache.bindTexture(target, texture)) {
+    return;
+  }
+#endif
+  ABCG_COUNT_GL_CALL(glBindTexture, Bind);
   callGL(sourceLocation, ::glBindTexture, target, texture);
 }
 inline void glBlendColor(
     GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBlendColor, State);
   callGL(sourceLocation, ::glBlendColor, red, green, blue, alpha);
 }
 inline void glBlendEquation(GLenum mode, source_location const &sourceLocation =
                                              source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBlendEquation, State);
   callGL(sourceLocation, ::glBlendEquation, mode);
 }
 inline void glBlendEquationSeparate(
     GLenum modeRGB, GLenum modeAlpha,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBlendEquationSeparate, State);
   callGL(sourceLocation, ::glBlendEquationSeparate, modeRGB, modeAlpha);
 }
 inline void glBlendFunc(
     GLenum sfactor, GLenum dfactor,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBlendFunc, State);
   callGL(sourceLocation, ::glBlendFunc, sfactor, dfactor);
 }
 inline void glBlendFuncSeparate(
     GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBlendFuncSeparate, State);
   callGL(sourceLocation, ::glBlendFuncSeparate, srcRGB, dstRGB, srcAlpha,
          dstAlpha);
 }
 inline void glBufferData(
     GLenum target, GLsizeiptr size, void const *data, GLenum usage,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL_BYTES(glBufferData, BufferUpload, size);
   callGL(sourceLocation, ::glBufferData, target, size, data, usage);
 }
 inline void glBufferSubData(
     GLenum target, GLintptr offset, GLsizeiptr size, void const *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL_BYTES(glBufferSubData, BufferUpload, size);
   callGL(sourceLocation, ::glBufferSubData, target, offset, size, data);
 }
 inline GLenum glCheckFramebufferStatus(
     GLenum target,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCheckFramebufferStatus, Other);
   return callGL(sourceLocation, ::glCheckFramebufferStatus, target);
 }
 inline void
 glClear(GLbitfield mask,
         source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClear, Other);
   callGL(sourceLocation, ::glClear, mask);
 }
 inline void glClearColor(
     GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClearColor, State);
   callGL(sourceLocation, ::glClearColor, red, green, blue, alpha);
 }
 inline void glClearDepthf(GLfloat d, source_location const &sourceLocation =
                                          source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClearDepthf, State);
   callGL(sourceLocation, ::glClearDepthf, d);
 }
 inline void glClearStencil(GLint s, source_location const &sourceLocation =
                                         source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClearStencil, State);
   callGL(sourceLocation, ::glClearStencil, s);
 }
 inline void glColorMask(
     GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glColorMask, State);
   callGL(sourceLocation, ::glColorMask, red, green, blue, alpha);
 }
 inline void glCompileShader(
     GLuint shader,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCompileShader, Other);
   callGL(sourceLocation, ::glCompileShader, shader);
 }
 inline void glCompressedTexImage2D(
     GLenum target, GLint level, GLenum internalformat, GLsizei width,
     GLsizei height, GLint border, GLsizei imageSize, void const *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCompressedTexImage2D, Other);
   callGL(sourceLocation, ::glCompressedTexImage2D, target, level,
          internalformat, width, height, border, imageSize, data);
 }
@@ -223,6 +382,7 @@ inline void glCompressedTexSubImage2D(
     GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
     GLsizei height, GLenum format, GLsizei imageSize, void const *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCompressedTexSubImage2D, Other);
   callGL(sourceLocation, ::glCompressedTexSubImage2D, target, level, xoffset,
          yoffset, width, height, format, imageSize, data);
 }
@@ -230,6 +390,7 @@ inline void glCopyTexImage2D(
     GLenum target, GLint level, GLenum internalformat, GLint x, GLint y,
     GLsizei width, GLsizei height, GLint border,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCopyTexImage2D, Other);
   callGL(sourceLocation, ::glCopyTexImage2D, target, level, internalformat, x,
          y, width, height, border);
 }
@@ -237,21 +398,25 @@ inline void glCopyTexSubImage2D(
     GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y,
     GLsizei width, GLsizei height,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCopyTexSubImage2D, Other);
   callGL(sourceLocation, ::glCopyTexSubImage2D, target, level, xoffset, yoffset,
          x, y, width, height);
 }
 inline GLuint glCreateProgram(
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCreateProgram, Other);
   return callGL(sourceLocation, ::glCreateProgram);
 }
 inline GLuint glCreateShader(
     GLenum shaderType,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCreateShader, Other);
   return callGL(sourceLocation, ::glCreateShader, shaderType);
 }
 inline void
 glCullFace(GLenum mode,
            source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCullFace, State);
   callGL(sourceLocation, ::glCullFace, mode);
 }
 inline void glDeleteBuffers(
@@ -260,6 +425,10 @@ inline void glDeleteBuffers(
   if (buffers == nullptr || *buffers == 0) {
     return;
   }
+#if defined(ABCG_GL_STATE_CACHE)
+  glStateCache.deleteBuffers({buffers, static_cast<std::size_t>(n)});
+#endif
+  ABCG_COUNT_GL_CALL(glDeleteBuffers, Other);
   callGL(sourceLocation, ::glDeleteBuffers, n, buffers);
 }
 inline void glDeleteFramebuffers(
@@ -268,6 +437,7 @@ inline void glDeleteFramebuffers(
   if (framebuffers == nullptr || *framebuffers == 0) {
     return;
   }
+  ABCG_COUNT_GL_CALL(glDeleteFramebuffers, Other);
   callGL(sourceLocation, ::glDeleteFramebuffers, n, framebuffers);
 }
 inline void glDeleteProgram(
@@ -276,6 +446,10 @@ inline void glDeleteProgram(
   if (program == 0) {
     return;
   }
+#if defined(ABCG_GL_STATE_CACHE)
+  glStateCache.deleteProgram(program);
+#endif
+  ABCG_COUNT_GL_CALL(glDeleteProgram, Other);
   callGL(sourceLocation, ::glDeleteProgram, program);
 }
 inline void glDeleteRenderbuffers(
@@ -284,6 +458,7 @@ inline void glDeleteRenderbuffers(
   if (renderbuffers == nullptr || *renderbuffers == 0) {
     return;
   }
+  ABCG_COUNT_GL_CALL(glDeleteRenderbuffers, Other);
   callGL(sourceLocation, ::glDeleteRenderbuffers, n, renderbuffers);
 }
 inline void glDeleteShader(
@@ -292,6 +467,7 @@ inline void glDeleteShader(
   if (shader == 0) {
     return;
   }
+  ABCG_COUNT_GL_CALL(glDeleteShader, Other);
   callGL(sourceLocation, ::glDeleteShader, shader);
 }
 inline void glDeleteTextures(
@@ -300,68 +476,85 @@ inline void glDeleteTextures(
   if (textures == nullptr || *textures == 0) {
     return;
   }
+#if defined(ABCG_GL_STATE_CACHE)
+  glStateCache.deleteTextures({textures, static_cast<std::size_t>(n)});
+#endif
+  ABCG_COUNT_GL_CALL(glDeleteTextures, Other);
   callGL(sourceLocation, ::glDeleteTextures, n, textures);
 }
 inline void glDepthFunc(GLenum func, source_location const &sourceLocation =
                                          source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDepthFunc, State);
   callGL(sourceLocation, ::glDepthFunc, func);
 }
 inline void glDepthMask(GLboolean flag, source_location const &sourceLocation =
                                             source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDepthMask, State);
   callGL(sourceLocation, ::glDepthMask, flag);
 }
 inline void glDepthRangef(
     GLfloat n, GLfloat f,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDepthRangef, State);
   callGL(sourceLocation, ::glDepthRangef, n, f);
 }
 inline void glDetachShader(
     GLuint program, GLuint shader,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDetachShader, Other);
   callGL(sourceLocation, ::glDetachShader, program, shader);
 }
 inline void
 glDisable(GLenum cap,
           source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDisable, State);
   callGL(sourceLocation, ::glDisable, cap);
 }
 inline void glDisableVertexAttribArray(
     GLuint index,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDisableVertexAttribArray, State);
   callGL(sourceLocation, ::glDisableVertexAttribArray, index);
 }
 inline void glDrawArrays(
     GLenum mode, GLint first, GLsizei count,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDrawArrays, Draw);
   callGL(sourceLocation, ::glDrawArrays, mode, first, count);
 }
 inline void glDrawElements(
     GLenum mode, GLsizei count, GLenum type, void const *indices,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDrawElements, Draw);
   callGL(sourceLocation, ::glDrawElements, mode, count, type, indices);
 }
 inline void
 glEnable(GLenum cap,
          source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glEnable, State);
   callGL(sourceLocation, ::glEnable, cap);
 }
 inline void glEnableVertexAttribArray(
     GLuint index,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glEnableVertexAttribArray, State);
   callGL(sourceLocation, ::glEnableVertexAttribArray, index);
 }
 inline void
 glFinish(source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFinish, Other);
   callGL(sourceLocation, ::glFinish);
 }
 inline void
 glFlush(source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFlush, Other);
   callGL(sourceLocation, ::glFlush);
 }
 inline void glFramebufferRenderbuffer(
     GLenum target, GLenum attachment, GLenum renderbuffertarget,
     GLuint renderbuffer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFramebufferRenderbuffer, Other);
   callGL(sourceLocation, ::glFramebufferRenderbuffer, target, attachment,
          renderbuffertarget, renderbuffer);
 }
@@ -369,42 +562,50 @@ inline void glFramebufferTexture2D(
     GLenum target, GLenum attachment, GLenum textarget, GLuint texture,
     GLint level,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFramebufferTexture2D, Other);
   callGL(sourceLocation, ::glFramebufferTexture2D, target, attachment,
          textarget, texture, level);
 }
 inline void glFrontFace(GLenum mode, source_location const &sourceLocation =
                                          source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFrontFace, State);
   callGL(sourceLocation, ::glFrontFace, mode);
 }
 inline void glGenBuffers(
     GLsizei n, GLuint *buffers,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenBuffers, Other);
   callGL(sourceLocation, ::glGenBuffers, n, buffers);
 }
 inline void glGenerateMipmap(
     GLenum target,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenerateMipmap, Other);
   callGL(sourceLocation, ::glGenerateMipmap, target);
 }
 inline void glGenFramebuffers(
     GLsizei n, GLuint *ids,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenFramebuffers, Other);
   callGL(sourceLocation, ::glGenFramebuffers, n, ids);
 }
 inline void glGenRenderbuffers(
     GLsizei n, GLuint *renderbuffers,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenRenderbuffers, Other);
   callGL(sourceLocation, ::glGenRenderbuffers, n, renderbuffers);
 }
 inline void glGenTextures(
     GLsizei n, GLuint *textures,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenTextures, Other);
   callGL(sourceLocation, ::glGenTextures, n, textures);
 }
 inline void glGetActiveAttrib(
     GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size,
     GLenum *type, GLchar *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetActiveAttrib, Other);
   callGL(sourceLocation, ::glGetActiveAttrib, program, index, bufSize, length,
          size, type, name);
 }
@@ -412,259 +613,309 @@ inline void glGetActiveUniform(
     GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size,
     GLenum *type, GLchar *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetActiveUniform, Other);
   callGL(sourceLocation, ::glGetActiveUniform, program, index, bufSize, length,
          size, type, name);
 }
 inline void glGetAttachedShaders(
     GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetAttachedShaders, Other);
   callGL(sourceLocation, ::glGetAttachedShaders, program, maxCount, count,
          shaders);
 }
 inline GLint glGetAttribLocation(
     GLuint program, GLchar const *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetAttribLocation, Other);
   return callGL(sourceLocation, ::glGetAttribLocation, program, name);
 }
 inline void glGetBooleanv(
     GLenum pname, GLboolean *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetBooleanv, Other);
   callGL(sourceLocation, ::glGetBooleanv, pname, params);
 }
 inline void glGetBufferParameteriv(
     GLenum target, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetBufferParameteriv, Other);
   callGL(sourceLocation, ::glGetBufferParameteriv, target, pname, params);
 }
 inline void glGetFloatv(
     GLenum pname, GLfloat *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetFloatv, Other);
   callGL(sourceLocation, ::glGetFloatv, pname, params);
 }
 inline void glGetFramebufferAttachmentParameteriv(
     GLenum target, GLenum attachment, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetFramebufferAttachmentParameteriv, Other);
   callGL(sourceLocation, ::glGetFramebufferAttachmentParameteriv, target,
          attachment, pname, params);
 }
 inline void glGetIntegerv(
     GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetIntegerv, Other);
   callGL(sourceLocation, ::glGetIntegerv, pname, params);
 }
 inline void glGetProgramiv(
     GLuint program, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetProgramiv, Other);
   callGL(sourceLocation, ::glGetProgramiv, program, pname, params);
 }
 inline void glGetProgramInfoLog(
     GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetProgramInfoLog, Other);
   callGL(sourceLocation, ::glGetProgramInfoLog, program, bufSize, length,
          infoLog);
 }
 inline void glGetRenderbufferParameteriv(
     GLenum target, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetRenderbufferParameteriv, Other);
   callGL(sourceLocation, ::glGetRenderbufferParameteriv, target, pname, params);
 }
 inline void glGetShaderiv(
     GLuint shader, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetShaderiv, Other);
   callGL(sourceLocation, ::glGetShaderiv, shader, pname, params);
 }
 inline void glGetShaderInfoLog(
     GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetShaderInfoLog, Other);
   callGL(sourceLocation, ::glGetShaderInfoLog, shader, bufSize, length,
          infoLog);
 }
 inline void glGetShaderPrecisionFormat(
     GLenum shadertype, GLenum precisiontype, GLint *range, GLint *precision,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetShaderPrecisionFormat, Other);
   callGL(sourceLocation, ::glGetShaderPrecisionFormat, shadertype,
          precisiontype, range, precision);
 }
 inline void glGetShaderSource(
     GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetShaderSource, Other);
   callGL(sourceLocation, ::glGetShaderSource, shader, bufSize, length, source);
 }
 inline const GLubyte *glGetString(
     GLenum name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetString, Other);
   return callGL(sourceLocation, ::glGetString, name);
 }
 inline void glGetTexParameterfv(
     GLenum target, GLenum pname, GLfloat *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetTexParameterfv, Other);
   callGL(sourceLocation, ::glGetTexParameterfv, target, pname, params);
 }
 inline void glGetTexParameteriv(
     GLenum target, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetTexParameteriv, Other);
   callGL(sourceLocation, ::glGetTexParameteriv, target, pname, params);
 }
 inline void glGetUniformfv(
     GLuint program, GLint location, GLfloat *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetUniformfv, Other);
   callGL(sourceLocation, ::glGetUniformfv, program, location, params);
 }
 inline void glGetUniformiv(
     GLuint program, GLint location, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetUniformiv, Other);
   callGL(sourceLocation, ::glGetUniformiv, program, location, params);
 }
 inline GLint glGetUniformLocation(
     GLuint program, GLchar const *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetUniformLocation, Other);
   return callGL(sourceLocation, ::glGetUniformLocation, program, name);
 }
 inline void glGetVertexAttribfv(
     GLuint index, GLenum pname, GLfloat *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetVertexAttribfv, Other);
   callGL(sourceLocation, ::glGetVertexAttribfv, index, pname, params);
 }
 inline void glGetVertexAttribiv(
     GLuint index, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetVertexAttribiv, Other);
   callGL(sourceLocation, ::glGetVertexAttribiv, index, pname, params);
 }
 inline void glGetVertexAttribPointerv(
     GLuint index, GLenum pname, void **pointer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetVertexAttribPointerv, Other);
   callGL(sourceLocation, ::glGetVertexAttribPointerv, index, pname, pointer);
 }
 inline void
 glHint(GLenum target, GLenum mode,
        source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glHint, State);
   callGL(sourceLocation, ::glHint, target, mode);
 }
 inline GLboolean
 glIsBuffer(GLuint buffer,
            source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsBuffer, Other);
   return callGL(sourceLocation, ::glIsBuffer, buffer);
 }
 inline GLboolean glIsEnabled(GLenum cap, source_location const &sourceLocation =
                                              source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsEnabled, Other);
   return callGL(sourceLocation, ::glIsEnabled, cap);
 }
 inline GLboolean glIsFramebuffer(
     GLuint framebuffer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsFramebuffer, Other);
   return callGL(sourceLocation, ::glIsFramebuffer, framebuffer);
 }
 inline GLboolean glIsProgram(
     GLuint program,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsProgram, Other);
   return callGL(sourceLocation, ::glIsProgram, program);
 }
 inline GLboolean glIsRenderbuffer(
     GLuint renderbuffer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsRenderbuffer, Other);
   return callGL(sourceLocation, ::glIsRenderbuffer, renderbuffer);
 }
 inline GLboolean
 glIsShader(GLuint shader,
            source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsShader, Other);
   return callGL(sourceLocation, ::glIsShader, shader);
 }
 inline GLboolean glIsTexture(
     GLuint texture,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsTexture, Other);
   return callGL(sourceLocation, ::glIsTexture, texture);
 }
 inline void glLineWidth(GLfloat width, source_location const &sourceLocation =
                                            source_location::current()) {
+  ABCG_COUNT_GL_CALL(glLineWidth, State);
   callGL(sourceLocation, ::glLineWidth, width);
 }
 inline void glLinkProgram(
     GLuint program,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glLinkProgram, Other);
   callGL(sourceLocation, ::glLinkProgram, program);
 }
 inline void glPixelStorei(
     GLenum pname, GLint param,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glPixelStorei, State);
   callGL(sourceLocation, ::glPixelStorei, pname, param);
 }
 inline void glPolygonOffset(
     GLfloat factor, GLfloat units,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glPolygonOffset, State);
   callGL(sourceLocation, ::glPolygonOffset, factor, units);
 }
 inline void glReadPixels(
     GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type,
     void *pixels,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glReadPixels, Other);
   callGL(sourceLocation, ::glReadPixels, x, y, width, height, format, type,
          pixels);
 }
 inline void glReleaseShaderCompiler(
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glReleaseShaderCompiler, Other);
   callGL(sourceLocation, ::glReleaseShaderCompiler);
 }
 inline void glRenderbufferStorage(
     GLenum target, GLenum internalformat, GLsizei width, GLsizei height,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glRenderbufferStorage, Other);
   callGL(sourceLocation, ::glRenderbufferStorage, target, internalformat, width,
          height);
 }
 inline void glSampleCoverage(
     GLfloat value, GLboolean invert,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glSampleCoverage, State);
   callGL(sourceLocation, ::glSampleCoverage, value, invert);
 }
 inline void
 glScissor(GLint x, GLint y, GLsizei width, GLsizei height,
           source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glScissor, State);
   callGL(sourceLocation, ::glScissor, x, y, width, height);
 }
 inline void glShaderBinary(
     GLsizei count, GLuint const *shaders, GLenum binaryformat,
     void const *binary, GLsizei length,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glShaderBinary, Other);
   callGL(sourceLocation, ::glShaderBinary, count, shaders, binaryformat, binary,
          length);
 }
 inline void glShaderSource(
     GLuint shader, GLsizei count, GLchar const **string, GLint const *length,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glShaderSource, Other);
   callGL(sourceLocation, ::glShaderSource, shader, count, string, length);
 }
 inline void glStencilFunc(
     GLenum func, GLint ref, GLuint mask,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glStencilFunc, State);
   callGL(sourceLocation, ::glStencilFunc, func, ref, mask);
 }
 inline void glStencilFuncSeparate(
     GLenum face, GLenum func, GLint ref, GLuint mask,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glStencilFuncSeparate, State);
   callGL(sourceLocation, ::glStencilFuncSeparate, face, func, ref, mask);
 }
 inline void glStencilMask(GLuint mask, source_location const &sourceLocation =
                                            source_location::current()) {
+  ABCG_COUNT_GL_CALL(glStencilMask, State);
   callGL(sourceLocation, ::glStencilMask, mask);
 }
 inline void glStencilMaskSeparate(
     GLenum face, GLuint mask,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glStencilMaskSeparate, State);
   callGL(sourceLocation, ::glStencilMaskSeparate, face, mask);
 }
 inline void glStencilOp(
     GLenum fail, GLenum zfail, GLenum zpass,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glStencilOp, State);
   callGL(sourceLocation, ::glStencilOp, fail, zfail, zpass);
 }
 inline void glStencilOpSeparate(
     GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glStencilOpSeparate, State);
   callGL(sourceLocation, ::glStencilOpSeparate, face, sfail, dpfail, dppass);
 }
 inline void glTexImage2D(
     GLenum target, GLint level, GLint internalformat, GLsizei width,
     GLsizei height, GLint border, GLenum format, GLenum type, void const *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexImage2D, Other);
   callGL(sourceLocation, ::glTexImage2D, target, level, internalformat, width,
          height, border, format, type, data);
 }
@@ -672,187 +923,228 @@ inline void glTexImage2D(
 inline void glTexParameterf(
     GLenum target, GLenum pname, GLfloat param,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexParameterf, State);
   callGL(sourceLocation, ::glTexParameterf, target, pname, param);
 }
 inline void glTexParameterfv(
     GLenum target, GLenum pname, GLfloat const *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexParameterfv, State);
   callGL(sourceLocation, ::glTexParameterfv, target, pname, params);
 }
 inline void glTexParameteri(
     GLenum target, GLenum pname, GLint param,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexParameteri, State);
   callGL(sourceLocation, ::glTexParameteri, target, pname, param);
 }
 inline void glTexParameteriv(
     GLenum target, GLenum pname, GLint const *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexParameteriv, State);
   callGL(sourceLocation, ::glTexParameteriv, target, pname, params);
 }
 inline void glTexSubImage2D(
     GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
     GLsizei height, GLenum format, GLenum type, void const *pixels,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexSubImage2D, Other);
   callGL(sourceLocation, ::glTexSubImage2D, target, level, xoffset, yoffset,
          width, height, format, type, pixels);
 }
 inline void glUniform1f(
     GLint location, GLfloat v0,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform1f, Uniform);
   callGL(sourceLocation, ::glUniform1f, location, v0);
 }
 inline void glUniform1fv(
     GLint location, GLsizei count, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform1fv, Uniform);
   callGL(sourceLocation, ::glUniform1fv, location, count, value);
 }
 inline void glUniform1i(
     GLint location, GLint v0,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform1i, Uniform);
   callGL(sourceLocation, ::glUniform1i, location, v0);
 }
 inline void glUniform1iv(
     GLint location, GLsizei count, GLint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform1iv, Uniform);
   callGL(sourceLocation, ::glUniform1iv, location, count, value);
 }
 inline void glUniform2f(
     GLint location, GLfloat v0, GLfloat v1,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform2f, Uniform);
   callGL(sourceLocation, ::glUniform2f, location, v0, v1);
 }
 inline void glUniform2fv(
     GLint location, GLsizei count, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform2fv, Uniform);
   callGL(sourceLocation, ::glUniform2fv, location, count, value);
 }
 inline void glUniform2i(
     GLint location, GLint v0, GLint v1,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform2i, Uniform);
   callGL(sourceLocation, ::glUniform2i, location, v0, v1);
 }
 inline void glUniform2iv(
     GLint location, GLsizei count, GLint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform2iv, Uniform);
   callGL(sourceLocation, ::glUniform2iv, location, count, value);
 }
 inline void glUniform3f(
     GLint location, GLfloat v0, GLfloat v1, GLfloat v2,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform3f, Uniform);
   callGL(sourceLocation, ::glUniform3f, location, v0, v1, v2);
 }
 inline void glUniform3fv(
     GLint location, GLsizei count, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform3fv, Uniform);
   callGL(sourceLocation, ::glUniform3fv, location, count, value);
 }
 inline void glUniform3i(
     GLint location, GLint v0, GLint v1, GLint v2,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform3i, Uniform);
   callGL(sourceLocation, ::glUniform3i, location, v0, v1, v2);
 }
 inline void glUniform3iv(
     GLint location, GLsizei count, GLint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform3iv, Uniform);
   callGL(sourceLocation, ::glUniform3iv, location, count, value);
 }
 inline void glUniform4f(
     GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform4f, Uniform);
   callGL(sourceLocation, ::glUniform4f, location, v0, v1, v2, v3);
 }
 inline void glUniform4fv(
     GLint location, GLsizei count, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform4fv, Uniform);
   callGL(sourceLocation, ::glUniform4fv, location, count, value);
 }
 inline void glUniform4i(
     GLint location, GLint v0, GLint v1, GLint v2, GLint v3,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform4i, Uniform);
   callGL(sourceLocation, ::glUniform4i, location, v0, v1, v2, v3);
 }
 inline void glUniform4iv(
     GLint location, GLsizei count, GLint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform4iv, Uniform);
   callGL(sourceLocation, ::glUniform4iv, location, count, value);
 }
 inline void glUniformMatrix2fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix2fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix2fv, location, count, transpose,
          value);
 }
 inline void glUniformMatrix3fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix3fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix3fv, location, count, transpose,
          value);
 }
 inline void glUniformMatrix4fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix4fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix4fv, location, count, transpose,
          value);
 }
 inline void glUseProgram(GLuint program, source_location const &sourceLocation =
                                              source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  if (glStateCache.useProgram(program)) {
+    return;
+  }
+#endif
+  ABCG_COUNT_GL_CALL(glUseProgram, Bind);
   callGL(sourceLocation, ::glUseProgram, program);
 }
 inline void glValidateProgram(
     GLuint program,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glValidateProgram, Other);
   callGL(sourceLocation, ::glValidateProgram, program);
 }
 inline void glVertexAttrib1f(
     GLuint index, GLfloat x,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib1f, Other);
   callGL(sourceLocation, ::glVertexAttrib1f, index, x);
 }
 inline void glVertexAttrib1fv(
     GLuint index, GLfloat const *v,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib1fv, Other);
   callGL(sourceLocation, ::glVertexAttrib1fv, index, v);
 }
 inline void glVertexAttrib2f(
     GLuint index, GLfloat x, GLfloat y,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib2f, Other);
   callGL(sourceLocation, ::glVertexAttrib2f, index, x, y);
 }
 inline void glVertexAttrib2fv(
     GLuint index, GLfloat const *v,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib2fv, Other);
   callGL(sourceLocation, ::glVertexAttrib2fv, index, v);
 }
 inline void glVertexAttrib3f(
     GLuint index, GLfloat x, GLfloat y, GLfloat z,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib3f, Other);
   callGL(sourceLocation, ::glVertexAttrib3f, index, x, y, z);
 }
 inline void glVertexAttrib3fv(
     GLuint index, GLfloat const *v,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib3fv, Other);
   callGL(sourceLocation, ::glVertexAttrib3fv, index, v);
 }
 inline void glVertexAttrib4f(
     GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib4f, Other);
   callGL(sourceLocation, ::glVertexAttrib4f, index, x, y, z, w);
 }
 inline void glVertexAttrib4fv(
     GLuint index, GLfloat const *v,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttrib4fv, Other);
   callGL(sourceLocation, ::glVertexAttrib4fv, index, v);
 }
 inline void glVertexAttribPointer(
     GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
     void const *pointer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttribPointer, State);
   callGL(sourceLocation, ::glVertexAttribPointer, index, size, type, normalized,
          stride, pointer);
 }
 inline void
 glViewport(GLint x, GLint y, GLsizei width, GLsizei height,
            source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glViewport, State);
   callGL(sourceLocation, ::glViewport, x, y, width, height);
 }
 
@@ -860,12 +1152,14 @@ glViewport(GLint x, GLint y, GLsizei width, GLsizei height,
 
 inline void glReadBuffer(GLenum src, source_location const &sourceLocation =
                                          source_location::current()) {
+  ABCG_COUNT_GL_CALL(glReadBuffer, State);
   callGL(sourceLocation, ::glReadBuffer, src);
 }
 inline void glDrawRangeElements(
     GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type,
     void const *indices,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDrawRangeElements, Draw);
   callGL(sourceLocation, ::glDrawRangeElements, mode, start, end, count, type,
          indices);
 }
@@ -874,6 +1168,7 @@ inline void glTexImage3D(
     GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type,
     void const *pixels,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexImage3D, Other);
   callGL(sourceLocation, ::glTexImage3D, target, level, internalformat, width,
          height, depth, border, format, type, pixels);
 }
@@ -882,6 +1177,7 @@ inline void glTexSubImage3D(
     GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type,
     void const *pixels,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexSubImage3D, Other);
   callGL(sourceLocation, ::glTexSubImage3D, target, level, xoffset, yoffset,
          zoffset, width, height, depth, format, type, pixels);
 }
@@ -889,6 +1185,7 @@ inline void glCopyTexSubImage3D(
     GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
     GLint x, GLint y, GLsizei width, GLsizei height,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCopyTexSubImage3D, Other);
   callGL(sourceLocation, ::glCopyTexSubImage3D, target, level, xoffset, yoffset,
          zoffset, x, y, width, height);
 }
@@ -897,6 +1194,7 @@ inline void glCompressedTexImage3D(
     GLsizei height, GLsizei depth, GLint border, GLsizei imageSize,
     void const *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCompressedTexImage3D, Other);
   callGL(sourceLocation, ::glCompressedTexImage3D, target, level,
          internalformat, width, height, depth, border, imageSize, data);
 }
@@ -905,92 +1203,109 @@ inline void glCompressedTexSubImage3D(
     GLsizei width, GLsizei height, GLsizei depth, GLenum format,
     GLsizei imageSize, void const *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCompressedTexSubImage3D, Other);
   callGL(sourceLocation, ::glCompressedTexSubImage3D, target, level, xoffset,
          yoffset, zoffset, width, height, depth, format, imageSize, data);
 }
 inline void glGenQueries(
     GLsizei n, GLuint *ids,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenQueries, Other);
   callGL(sourceLocation, ::glGenQueries, n, ids);
 }
 inline void glDeleteQueries(
     GLsizei n, GLuint const *ids,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDeleteQueries, Other);
   callGL(sourceLocation, ::glDeleteQueries, n, ids);
 }
 inline GLboolean
 glIsQuery(GLuint id,
           source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsQuery, Other);
   return callGL(sourceLocation, ::glIsQuery, id);
 }
 inline void glBeginQuery(
     GLenum target, GLuint id,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBeginQuery, Other);
   callGL(sourceLocation, ::glBeginQuery, target, id);
 }
 inline void
 glEndQuery(GLenum target,
            source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glEndQuery, Other);
   callGL(sourceLocation, ::glEndQuery, target);
 }
 inline void glGetQueryiv(
     GLenum target, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetQueryiv, Other);
   callGL(sourceLocation, ::glGetQueryiv, target, pname, params);
 }
 inline void glGetQueryObjectuiv(
     GLuint id, GLenum pname, GLuint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetQueryObjectuiv, Other);
   callGL(sourceLocation, ::glGetQueryObjectuiv, id, pname, params);
 }
 inline GLboolean glUnmapBuffer(
     GLenum target,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUnmapBuffer, Other);
   return callGL(sourceLocation, ::glUnmapBuffer, target);
 }
 inline void glGetBufferPointerv(
     GLenum target, GLenum pname, void **params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetBufferPointerv, Other);
   callGL(sourceLocation, ::glGetBufferPointerv, target, pname, params);
 }
 inline void glDrawBuffers(
     GLsizei n, GLenum const *bufs,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDrawBuffers, State);
   callGL(sourceLocation, ::glDrawBuffers, n, bufs);
 }
 inline void glUniformMatrix2x3fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix2x3fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix2x3fv, location, count, transpose,
          value);
 }
 inline void glUniformMatrix3x2fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix3x2fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix3x2fv, location, count, transpose,
          value);
 }
 inline void glUniformMatrix2x4fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix2x4fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix2x4fv, location, count, transpose,
          value);
 }
 inline void glUniformMatrix4x2fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix4x2fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix4x2fv, location, count, transpose,
          value);
 }
 inline void glUniformMatrix3x4fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix3x4fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix3x4fv, location, count, transpose,
          value);
 }
 inline void glUniformMatrix4x3fv(
     GLint location, GLsizei count, GLboolean transpose, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformMatrix4x3fv, Uniform);
   callGL(sourceLocation, ::glUniformMatrix4x3fv, location, count, transpose,
          value);
 }
@@ -998,6 +1313,7 @@ inline void glBlitFramebuffer(
     GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0,
     GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBlitFramebuffer, Other);
   callGL(sourceLocation, ::glBlitFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0,
          dstY0, dstX1, dstY1, mask, filter);
 }
@@ -1005,76 +1321,104 @@ inline void glRenderbufferStorageMultisample(
     GLenum target, GLsizei samples, GLenum internalformat, GLsizei width,
     GLsizei height,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glRenderbufferStorageMultisample, Other);
   callGL(sourceLocation, ::glRenderbufferStorageMultisample, target, samples,
          internalformat, width, height);
 }
 inline void glFramebufferTextureLayer(
     GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFramebufferTextureLayer, Other);
   callGL(sourceLocation, ::glFramebufferTextureLayer, target, attachment,
          texture, level, layer);
 }
 inline void *glMapBufferRange(
     GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glMapBufferRange, Other);
   return callGL(sourceLocation, ::glMapBufferRange, target, offset, length,
                 access);
 }
 inline void glFlushMappedBufferRange(
     GLenum target, GLintptr offset, GLsizeiptr length,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFlushMappedBufferRange, Other);
   callGL(sourceLocation, ::glFlushMappedBufferRange, target, offset, length);
 }
 inline void glBindVertexArray(
     GLuint array,
     source_location const &sourceLocation = source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  if (glStateCache.bindVertexArray(array)) {
+    return;
+  }
+#endif
+  ABCG_COUNT_GL_CALL(glBindVertexArray, Bind);
   callGL(sourceLocation, ::glBindVertexArray, array);
 }
 inline void glDeleteVertexArrays(
     GLsizei n, GLuint const *arrays,
     source_location const &sourceLocation = source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  glStateCache.deleteVertexArrays({arrays, static_cast<std::size_t>(n)});
+#endif
+  ABCG_COUNT_GL_CALL(glDeleteVertexArrays, Other);
   callGL(sourceLocation, ::glDeleteVertexArrays, n, arrays);
 }
 inline void glGenVertexArrays(
     GLsizei n, GLuint *arrays,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenVertexArrays, Other);
   callGL(sourceLocation, ::glGenVertexArrays, n, arrays);
 }
 inline GLboolean glIsVertexArray(
     GLuint array,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsVertexArray, Other);
   return callGL(sourceLocation, ::glIsVertexArray, array);
 }
 inline void glGetIntegeri_v(
     GLenum target, GLuint index, GLint *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetIntegeri_v, Other);
   callGL(sourceLocation, ::glGetIntegeri_v, target, index, data);
 }
 inline void glBeginTransformFeedback(
     GLenum primitiveMode,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBeginTransformFeedback, Other);
   callGL(sourceLocation, ::glBeginTransformFeedback, primitiveMode);
 }
 inline void glEndTransformFeedback(
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glEndTransformFeedback, Other);
   callGL(sourceLocation, ::glEndTransformFeedback);
 }
 inline void glBindBufferRange(
     GLenum target, GLuint index, GLuint buffer, GLintptr offset,
     GLsizeiptr size,
     source_location const &sourceLocation = source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  glStateCache.bindBufferBase(target, buffer);
+#endif
+  ABCG_COUNT_GL_CALL(glBindBufferRange, Bind);
   callGL(sourceLocation, ::glBindBufferRange, target, index, buffer, offset,
          size);
 }
 inline void glBindBufferBase(
     GLenum target, GLuint index, GLuint buffer,
     source_location const &sourceLocation = source_location::current()) {
+#if defined(ABCG_GL_STATE_CACHE)
+  glStateCache.bindBufferBase(target, buffer);
+#endif
+  ABCG_COUNT_GL_CALL(glBindBufferBase, Bind);
   callGL(sourceLocation, ::glBindBufferBase, target, index, buffer);
 }
 inline void glTransformFeedbackVaryings(
     GLuint program, GLsizei count, GLchar const *const *varyings,
     GLenum bufferMode,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTransformFeedbackVaryings, Other);
   callGL(sourceLocation, ::glTransformFeedbackVaryings, program, count,
          varyings, bufferMode);
 }
@@ -1082,124 +1426,148 @@ inline void glGetTransformFeedbackVarying(
     GLuint program, GLuint index, GLsizei bufSize, GLsizei *length,
     GLsizei *size, GLenum *type, GLchar *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetTransformFeedbackVarying, Other);
   callGL(sourceLocation, ::glGetTransformFeedbackVarying, program, index,
          bufSize, length, size, type, name);
 }
 inline void glVertexAttribIPointer(
     GLuint index, GLint size, GLenum type, GLsizei stride, void const *pointer,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttribIPointer, State);
   callGL(sourceLocation, ::glVertexAttribIPointer, index, size, type, stride,
          pointer);
 }
 inline void glGetVertexAttribIiv(
     GLuint index, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetVertexAttribIiv, Other);
   callGL(sourceLocation, ::glGetVertexAttribIiv, index, pname, params);
 }
 inline void glGetVertexAttribIuiv(
     GLuint index, GLenum pname, GLuint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetVertexAttribIuiv, Other);
   callGL(sourceLocation, ::glGetVertexAttribIuiv, index, pname, params);
 }
 inline void glVertexAttribI4i(
     GLuint index, GLint x, GLint y, GLint z, GLint w,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttribI4i, Other);
   callGL(sourceLocation, ::glVertexAttribI4i, index, x, y, z, w);
 }
 inline void glVertexAttribI4ui(
     GLuint index, GLuint x, GLuint y, GLuint z, GLuint w,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttribI4ui, Other);
   callGL(sourceLocation, ::glVertexAttribI4ui, index, x, y, z, w);
 }
 inline void glVertexAttribI4iv(
     GLuint index, GLint const *v,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttribI4iv, Other);
   callGL(sourceLocation, ::glVertexAttribI4iv, index, v);
 }
 inline void glVertexAttribI4uiv(
     GLuint index, GLuint const *v,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttribI4uiv, Other);
   callGL(sourceLocation, ::glVertexAttribI4uiv, index, v);
 }
 inline void glGetUniformuiv(
     GLuint program, GLint location, GLuint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetUniformuiv, Other);
   callGL(sourceLocation, ::glGetUniformuiv, program, location, params);
 }
 inline GLint glGetFragDataLocation(
     GLuint program, GLchar const *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetFragDataLocation, Other);
   return callGL(sourceLocation, ::glGetFragDataLocation, program, name);
 }
 inline void glUniform1ui(
     GLint location, GLuint v0,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform1ui, Uniform);
   callGL(sourceLocation, ::glUniform1ui, location, v0);
 }
 inline void glUniform2ui(
     GLint location, GLuint v0, GLuint v1,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform2ui, Uniform);
   callGL(sourceLocation, ::glUniform2ui, location, v0, v1);
 }
 inline void glUniform3ui(
     GLint location, GLuint v0, GLuint v1, GLuint v2,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform3ui, Uniform);
   callGL(sourceLocation, ::glUniform3ui, location, v0, v1, v2);
 }
 inline void glUniform4ui(
     GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform4ui, Uniform);
   callGL(sourceLocation, ::glUniform4ui, location, v0, v1, v2, v3);
 }
 inline void glUniform1uiv(
     GLint location, GLsizei count, GLuint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform1uiv, Uniform);
   callGL(sourceLocation, ::glUniform1uiv, location, count, value);
 }
 inline void glUniform2uiv(
     GLint location, GLsizei count, GLuint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform2uiv, Uniform);
   callGL(sourceLocation, ::glUniform2uiv, location, count, value);
 }
 inline void glUniform3uiv(
     GLint location, GLsizei count, GLuint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform3uiv, Uniform);
   callGL(sourceLocation, ::glUniform3uiv, location, count, value);
 }
 inline void glUniform4uiv(
     GLint location, GLsizei count, GLuint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniform4uiv, Uniform);
   callGL(sourceLocation, ::glUniform4uiv, location, count, value);
 }
 inline void glClearBufferiv(
     GLenum buffer, GLint drawbuffer, GLint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClearBufferiv, Other);
   callGL(sourceLocation, ::glClearBufferiv, buffer, drawbuffer, value);
 }
 inline void glClearBufferuiv(
     GLenum buffer, GLint drawbuffer, GLuint const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClearBufferuiv, Other);
   callGL(sourceLocation, ::glClearBufferuiv, buffer, drawbuffer, value);
 }
 inline void glClearBufferfv(
     GLenum buffer, GLint drawbuffer, GLfloat const *value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClearBufferfv, Other);
   callGL(sourceLocation, ::glClearBufferfv, buffer, drawbuffer, value);
 }
 inline void glClearBufferfi(
     GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClearBufferfi, Other);
   callGL(sourceLocation, ::glClearBufferfi, buffer, drawbuffer, depth, stencil);
 }
 inline const GLubyte *glGetStringi(
     GLenum name, GLuint index,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetStringi, Other);
   return callGL(sourceLocation, ::glGetStringi, name, index);
 }
 inline void glCopyBufferSubData(
     GLenum readTarget, GLenum writeTarget, GLintptr readOffset,
     GLintptr writeOffset, GLsizeiptr size,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glCopyBufferSubData, Other);
   callGL(sourceLocation, ::glCopyBufferSubData, readTarget, writeTarget,
          readOffset, writeOffset, size);
 }
@@ -1207,6 +1575,7 @@ inline void glGetUniformIndices(
     GLuint program, GLsizei uniformCount, GLchar const *const *uniformNames,
     GLuint *uniformIndices,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetUniformIndices, Other);
   callGL(sourceLocation, ::glGetUniformIndices, program, uniformCount,
          uniformNames, uniformIndices);
 }
@@ -1214,18 +1583,21 @@ inline void glGetActiveUniformsiv(
     GLuint program, GLsizei uniformCount, GLuint const *uniformIndices,
     GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetActiveUniformsiv, Other);
   callGL(sourceLocation, ::glGetActiveUniformsiv, program, uniformCount,
          uniformIndices, pname, params);
 }
 inline GLuint glGetUniformBlockIndex(
     GLuint program, GLchar const *uniformBlockName,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetUniformBlockIndex, Other);
   return callGL(sourceLocation, ::glGetUniformBlockIndex, program,
                 uniformBlockName);
 }
 inline void glGetActiveUniformBlockiv(
     GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetActiveUniformBlockiv, Other);
   callGL(sourceLocation, ::glGetActiveUniformBlockiv, program,
          uniformBlockIndex, pname, params);
 }
@@ -1233,12 +1605,14 @@ inline void glGetActiveUniformBlockName(
     GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length,
     GLchar *uniformBlockName,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetActiveUniformBlockName, Other);
   callGL(sourceLocation, ::glGetActiveUniformBlockName, program,
          uniformBlockIndex, bufSize, length, uniformBlockName);
 }
 inline void glUniformBlockBinding(
     GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glUniformBlockBinding, Other);
   callGL(sourceLocation, ::glUniformBlockBinding, program, uniformBlockIndex,
          uniformBlockBinding);
 }
@@ -1246,6 +1620,7 @@ inline void glUniformBlockBinding(
 inline void glDrawArraysInstanced(
     GLenum mode, GLint first, GLsizei count, GLsizei instancecount,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDrawArraysInstanced, Draw);
   callGL(sourceLocation, ::glDrawArraysInstanced, mode, first, count,
          instancecount);
 }
@@ -1253,157 +1628,188 @@ inline void glDrawElementsInstanced(
     GLenum mode, GLsizei count, GLenum type, void const *indices,
     GLsizei instancecount,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDrawElementsInstanced, Draw);
   callGL(sourceLocation, ::glDrawElementsInstanced, mode, count, type, indices,
          instancecount);
 }
 inline GLsync glFenceSync(
     GLenum condition, GLbitfield flags,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFenceSync, Other);
   return callGL(sourceLocation, ::glFenceSync, condition, flags);
 }
 inline GLboolean
 glIsSync(GLsync sync,
          source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsSync, Other);
   return callGL(sourceLocation, ::glIsSync, sync);
 }
 inline void glDeleteSync(GLsync sync, source_location const &sourceLocation =
                                           source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDeleteSync, Other);
   callGL(sourceLocation, ::glDeleteSync, sync);
 }
 inline GLenum glClientWaitSync(
     GLsync sync, GLbitfield flags, GLuint64 timeout,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glClientWaitSync, Other);
   return callGL(sourceLocation, ::glClientWaitSync, sync, flags, timeout);
 }
 inline void
 glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout,
            source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glWaitSync, Other);
   callGL(sourceLocation, ::glWaitSync, sync, flags, timeout);
 }
 inline void glGetInteger64v(
     GLenum pname, GLint64 *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetInteger64v, Other);
   callGL(sourceLocation, ::glGetInteger64v, pname, data);
 }
 inline void glGetSynciv(
     GLsync sync, GLenum pname, GLsizei count, GLsizei *length, GLint *values,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetSynciv, Other);
   callGL(sourceLocation, ::glGetSynciv, sync, pname, count, length, values);
 }
 inline void glGetInteger64i_v(
     GLenum target, GLuint index, GLint64 *data,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetInteger64i_v, Other);
   callGL(sourceLocation, ::glGetInteger64i_v, target, index, data);
 }
 inline void glGetBufferParameteri64v(
     GLenum target, GLenum pname, GLint64 *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetBufferParameteri64v, Other);
   callGL(sourceLocation, ::glGetBufferParameteri64v, target, pname, params);
 }
 inline void glGenSamplers(
     GLsizei count, GLuint *samplers,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenSamplers, Other);
   callGL(sourceLocation, ::glGenSamplers, count, samplers);
 }
 inline void glDeleteSamplers(
     GLsizei count, GLuint const *samplers,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDeleteSamplers, Other);
   callGL(sourceLocation, ::glDeleteSamplers, count, samplers);
 }
 inline GLboolean glIsSampler(
     GLuint sampler,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsSampler, Other);
   return callGL(sourceLocation, ::glIsSampler, sampler);
 }
 inline void glBindSampler(
     GLuint unit, GLuint sampler,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBindSampler, Bind);
   callGL(sourceLocation, ::glBindSampler, unit, sampler);
 }
 inline void glSamplerParameteri(
     GLuint sampler, GLenum pname, GLint param,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glSamplerParameteri, State);
   callGL(sourceLocation, ::glSamplerParameteri, sampler, pname, param);
 }
 inline void glSamplerParameteriv(
     GLuint sampler, GLenum pname, GLint const *param,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glSamplerParameteriv, State);
   callGL(sourceLocation, ::glSamplerParameteriv, sampler, pname, param);
 }
 inline void glSamplerParameterf(
     GLuint sampler, GLenum pname, GLfloat param,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glSamplerParameterf, State);
   callGL(sourceLocation, ::glSamplerParameterf, sampler, pname, param);
 }
 inline void glSamplerParameterfv(
     GLuint sampler, GLenum pname, GLfloat const *param,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glSamplerParameterfv, State);
   callGL(sourceLocation, ::glSamplerParameterfv, sampler, pname, param);
 }
 inline void glGetSamplerParameteriv(
     GLuint sampler, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetSamplerParameteriv, Other);
   callGL(sourceLocation, ::glGetSamplerParameteriv, sampler, pname, params);
 }
 inline void glGetSamplerParameterfv(
     GLuint sampler, GLenum pname, GLfloat *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetSamplerParameterfv, Other);
   callGL(sourceLocation, ::glGetSamplerParameterfv, sampler, pname, params);
 }
 inline void glVertexAttribDivisor(
     GLuint index, GLuint divisor,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glVertexAttribDivisor, State);
   callGL(sourceLocation, ::glVertexAttribDivisor, index, divisor);
 }
 inline void glBindTransformFeedback(
     GLenum target, GLuint id,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBindTransformFeedback, Bind);
   callGL(sourceLocation, ::glBindTransformFeedback, target, id);
 }
 inline void glDeleteTransformFeedbacks(
     GLsizei n, GLuint const *ids,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glDeleteTransformFeedbacks, Other);
   callGL(sourceLocation, ::glDeleteTransformFeedbacks, n, ids);
 }
 inline void glGenTransformFeedbacks(
     GLsizei n, GLuint *ids,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGenTransformFeedbacks, Other);
   callGL(sourceLocation, ::glGenTransformFeedbacks, n, ids);
 }
 inline GLboolean glIsTransformFeedback(
     GLuint id,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glIsTransformFeedback, Other);
   return callGL(sourceLocation, ::glIsTransformFeedback, id);
 }
 inline void glPauseTransformFeedback(
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glPauseTransformFeedback, Other);
   callGL(sourceLocation, ::glPauseTransformFeedback);
 }
 inline void glResumeTransformFeedback(
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glResumeTransformFeedback, Other);
   callGL(sourceLocation, ::glResumeTransformFeedback);
 }
 inline void glGetProgramBinary(
     GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat,
     void *binary,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetProgramBinary, Other);
   callGL(sourceLocation, ::glGetProgramBinary, program, bufSize, length,
          binaryFormat, binary);
 }
 inline void glProgramBinary(
     GLuint program, GLenum binaryFormat, void const *binary, GLsizei length,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glProgramBinary, Other);
   callGL(sourceLocation, ::glProgramBinary, program, binaryFormat, binary,
          length);
 }
 inline void glProgramParameteri(
     GLuint program, GLenum pname, GLint value,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glProgramParameteri, Other);
   callGL(sourceLocation, ::glProgramParameteri, program, pname, value);
 }
 inline void glInvalidateFramebuffer(
     GLenum target, GLsizei numAttachments, GLenum const *attachments,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glInvalidateFramebuffer, Other);
   callGL(sourceLocation, ::glInvalidateFramebuffer, target, numAttachments,
          attachments);
 }
@@ -1411,6 +1817,7 @@ inline void glInvalidateSubFramebuffer(
     GLenum target, GLsizei numAttachments, GLenum const *attachments, GLint x,
     GLint y, GLsizei width, GLsizei height,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glInvalidateSubFramebuffer, Other);
   callGL(sourceLocation, ::glInvalidateSubFramebuffer, target, numAttachments,
          attachments, x, y, width, height);
 }
@@ -1418,6 +1825,7 @@ inline void glTexStorage2D(
     GLenum target, GLsizei levels, GLenum internalformat, GLsizei width,
     GLsizei height,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexStorage2D, Other);
   callGL(sourceLocation, ::glTexStorage2D, target, levels, internalformat,
          width, height);
 }
@@ -1425,6 +1833,7 @@ inline void glTexStorage3D(
     GLenum target, GLsizei levels, GLenum internalformat, GLsizei width,
     GLsizei height, GLsizei depth,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexStorage3D, Other);
   callGL(sourceLocation, ::glTexStorage3D, target, levels, internalformat,
          width, height, depth);
 }
@@ -1432,6 +1841,7 @@ inline void glGetInternalformativ(
     GLenum target, GLenum internalformat, GLenum pname, GLsizei count,
     GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetInternalformativ, Other);
   callGL(sourceLocation, ::glGetInternalformativ, target, internalformat, pname,
          count, params);
 }
@@ -1443,6 +1853,7 @@ inline void glGetInternalformativ(
 inline void glBindFragDataLocation(
     GLuint program, GLuint colorNumber, char const *name,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glBindFragDataLocation, Other);
   callGL(sourceLocation, ::glBindFragDataLocation, program, colorNumber, name);
 }
 
@@ -1450,12 +1861,14 @@ inline void glBindFragDataLocation(
 inline void glGetTexLevelParameterfv(
     GLenum target, GLint level, GLenum pname, GLfloat *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetTexLevelParameterfv, Other);
   callGL(sourceLocation, ::glGetTexLevelParameterfv, target, level, pname,
          params);
 }
 inline void glGetTexLevelParameteriv(
     GLenum target, GLint level, GLenum pname, GLint *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetTexLevelParameteriv, Other);
   callGL(sourceLocation, ::glGetTexLevelParameteriv, target, level, pname,
          params);
 }
@@ -1465,6 +1878,7 @@ inline void glGetTexLevelParameteriv(
 inline void glFramebufferTexture(
     GLenum target, GLenum attachment, GLuint texture, GLint level,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glFramebufferTexture, Other);
   callGL(sourceLocation, ::glFramebufferTexture, target, attachment, texture,
          level);
 }
@@ -1473,6 +1887,7 @@ inline void glTexImage2DMultisample(
     GLenum target, GLsizei samples, GLenum internalformat, GLsizei width,
     GLsizei height, GLboolean fixedsamplelocations,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glTexImage2DMultisample, Other);
   callGL(sourceLocation, ::glTexImage2DMultisample, target, samples,
          internalformat, width, height, fixedsamplelocations);
 }
@@ -1482,6 +1897,7 @@ inline void glTexImage2DMultisample(
 inline void glGetDoublev(
     GLenum pname, GLdouble *params,
     source_location const &sourceLocation = source_location::current()) {
+  ABCG_COUNT_GL_CALL(glGetDoublev, Other);
   callGL(sourceLocation, ::glGetDoublev, pname, params);
 }
 #endif
@@ -0,0 +1,303 @@
+/**
+ * @file abcgOpenGLGPUTimer.cpp
+ * @brief Definition of abcg::OpenGLGPUTimer members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLGPUTimer.hpp"
+
+#if defined(__EMSCRIPTEN__)
+#include <GLES2/gl2ext.h>
+#endif
+
+#include <gsl/gsl>
+
+#include <string_view>
+
+namespace {
+[[nodiscard]] bool isOpenGLES() {
+  auto const *version{reinterpret_cast<char const *>(glGetString(GL_VERSION))};
+  return version != nullptr &&
+         std::string_view{version}.starts_with("OpenGL ES");
+}
+
+[[nodiscard]] double toMilliseconds(GLuint64 nanoseconds) {
+  return static_cast<double>(nanoseconds) / 1.0e6;
+}
+} // namespace
+
+/**
+ * @brief Checks for timer query support and selects the type of query to use.
+ *
+ * This is called by abcg::OpenGLWindow after the OpenGL context is created.
+ */
+void abcg::OpenGLGPUTimer::create() {
+  destroy();
+
+#if defined(__EMSCRIPTEN__)
+  m_useEXT = true;
+  auto const supported{
+      emscripten_webgl_enable_extension(emscripten_webgl_get_current_context(),
+                                        "EXT_disjoint_timer_query_webgl2") ==
+      EM_TRUE};
+#else
+  m_useEXT = isOpenGLES();
+  auto const supported{m_useEXT ? GLEW_EXT_disjoint_timer_query == GL_TRUE
+                                : (GLEW_VERSION_3_3 == GL_TRUE ||
+                                   GLEW_ARB_timer_query == GL_TRUE)};
+#endif
+
+  if (!supported) {
+    m_mode = Mode::Unsupported;
+    return;
+  }
+
+  // Some implementations (e.g., most WebGL ones) report timestamp queries with
+  // zero bits, meaning that only GL_TIME_ELAPSED queries can be used
+  GLint timestampBits{};
+  glGetQueryiv(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT, &timestampBits);
+  // Clear any error raised by the query above
+  while (glGetError() != GL_NO_ERROR) {
+  }
+  m_mode = timestampBits > 0 ? Mode::Timestamp : Mode::TimeElapsed;
+}
+
+/**
+ * @brief Releases the query objects.
+ *
+ * This is called by abcg::OpenGLWindow before the OpenGL context is destroyed.
+ */
+void abcg::OpenGLGPUTimer::destroy() {
+  for (auto &frame : m_frames) {
+    if (!frame.queries.empty()) {
+      glDeleteQueries(gsl::narrow<GLsizei>(frame.queries.size()),
+                      frame.queries.data());
+    }
+    frame = {};
+  }
+  m_frameIndex = 0;
+  m_inFrame = false;
+  m_openPasses.clear();
+  m_frameTime = 0.0;
+  m_passTimes.clear();
+}
+
+/**
+ * @brief Returns whether timer queries are supported by the OpenGL context.
+ *
+ * @return `true` if the GPU time can be measured, `false` otherwise.
+ */
+bool abcg::OpenGLGPUTimer::isSupported() const noexcept {
+  return m_mode != Mode::Unsupported;
+}
+
+/**
+ * @brief Starts measuring a frame.
+ *
+ * If the queries of the frame issued abcg::OpenGLGPUTimer::frameLatency frames
+ * ago are available, their results are read and can be retrieved with
+ * abcg::OpenGLGPUTimer::getFrameTime and abcg::OpenGLGPUTimer::getPassTimes.
+ * Otherwise, the results of that frame are discarded.
+ */
+void abcg::OpenGLGPUTimer::beginFrame() {
+  if (m_mode == Mode::Unsupported) {
+    return;
+  }
+
+  auto &frame{m_frames.at(m_frameIndex)};
+  if (frame.pending) {
+    collect(frame);
+  }
+  frame.numQueries = 0;
+  frame.passes.clear();
+  m_openPasses.clear();
+  m_inFrame = true;
+
+  if (m_mode == Mode::Timestamp) {
+    // The first query of the frame marks its beginning
+    [[maybe_unused]] auto const beginQuery{issueTimestamp(frame)};
+  }
+}
+
+/**
+ * @brief Finishes measuring the current frame.
+ *
+ * Passes that are still open are ended.
+ */
+void abcg::OpenGLGPUTimer::endFrame() {
+  if (!m_inFrame) {
+    return;
+  }
+  while (!m_openPasses.empty()) {
+    endPass();
+  }
+
+  auto &frame{m_frames.at(m_frameIndex)};
+  if (m_mode == Mode::Timestamp) {
+    // The last query of the frame marks its end
+    [[maybe_unused]] auto const endQuery{issueTimestamp(frame)};
+  }
+  frame.pending = frame.numQueries > 0;
+  m_frameIndex = (m_frameIndex + 1) % frameLatency;
+  m_inFrame = false;
+}
+
+/**
+ * @brief Starts measuring a named pass of the current frame.
+ *
+ * Each call must be matched by a call to abcg::OpenGLGPUTimer::endPass.
+ *
+ * @param name Name of the pass.
+ */
+void abcg::OpenGLGPUTimer::beginPass(std::string_view name) {
+  if (!m_inFrame) {
+    return;
+  }
+
+  auto &frame{m_frames.at(m_frameIndex)};
+  Pass pass{.name = std::string{name}};
+
+  if (m_mode == Mode::Timestamp) {
+    pass.beginQuery = issueTimestamp(frame);
+  } else if (!m_openPasses.empty()) {
+    // GL_TIME_ELAPSED queries cannot be nested
+    pass.measured = false;
+  } else {
+    if (frame.numQueries == frame.queries.size()) {
+      frame.queries.push_back(0);
+      glGenQueries(1, &frame.queries.back());
+    }
+    pass.beginQuery = frame.numQueries++;
+    glBeginQuery(GL_TIME_ELAPSED_EXT, frame.queries.at(pass.beginQuery));
+  }
+
+  m_openPasses.push_back(frame.passes.size());
+  frame.passes.push_back(std::move(pass));
+}
+
+/**
+ * @brief Finishes measuring the pass started by the last unmatched call to
+ * abcg::OpenGLGPUTimer::beginPass.
+ */
+void abcg::OpenGLGPUTimer::endPass() {
+  if (!m_inFrame || m_openPasses.empty()) {
+    return;
+  }
+
+  auto &frame{m_frames.at(m_frameIndex)};
+  auto &pass{frame.passes.at(m_openPasses.back())};
+  m_openPasses.pop_back();
+
+  if (m_mode == Mode::Timestamp) {
+    pass.endQuery = issueTimestamp(frame);
+  } else if (pass.measured) {
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+  }
+}
+
+/**
+ * @brief Returns the GPU time of the most recent frame whose results are
+ * available.
+ *
+ * If timestamp queries are not supported, this is the sum of the time of the
+ * passes of the frame.
+ *
+ * @return GPU time, in milliseconds, or zero if no result is available.
+ */
+double abcg::OpenGLGPUTimer::getFrameTime() const noexcept {
+  return m_frameTime;
+}
+
+/**
+ * @brief Returns the GPU time of the passes of the most recent frame whose
+ * results are available.
+ *
+ * @return Passes in the order they were started. Nested passes that could not
+ * be measured are not included.
+ */
+std::span<abcg::GPUPassTime const>
+abcg::OpenGLGPUTimer::getPassTimes() const noexcept {
+  return m_passTimes;
+}
+
+std::size_t abcg::OpenGLGPUTimer::issueTimestamp(Frame &frame) {
+  if (frame.numQueries == frame.queries.size()) {
+    frame.queries.push_back(0);
+    glGenQueries(1, &frame.queries.back());
+  }
+  auto const index{frame.numQueries++};
+#if defined(__EMSCRIPTEN__)
+  glQueryCounterEXT(frame.queries.at(index), GL_TIMESTAMP_EXT);
+#else
+  if (m_useEXT) {
+    glQueryCounterEXT(frame.queries.at(index), GL_TIMESTAMP_EXT);
+  } else {
+    glQueryCounter(frame.queries.at(index), GL_TIMESTAMP);
+  }
+#endif
+  return index;
+}
+
+void abcg::OpenGLGPUTimer::collect(Frame &frame) {
+  frame.pending = false;
+
+  // Queries complete in order, so the last one tells whether all results are
+  // available. If not, drop the frame rather than stall
+  GLuint available{};
+  glGetQueryObjectuiv(frame.queries.at(frame.numQueries - 1),
+                      GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available == GL_FALSE) {
+    return;
+  }
+
+  if (m_useEXT) {
+    // Results are undefined if the GPU was reset or its clock changed
+    GLint disjoint{};
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint != 0) {
+      return;
+    }
+  }
+
+  auto const getResult{[this, &frame](std::size_t index) {
+    GLuint64 result{};
+#if defined(__EMSCRIPTEN__)
+    glGetQueryObjectui64vEXT(frame.queries.at(index), GL_QUERY_RESULT,
+                             &result);
+#else
+    if (m_useEXT) {
+      glGetQueryObjectui64vEXT(frame.queries.at(index), GL_QUERY_RESULT,
+                               &result);
+    } else {
+      glGetQueryObjectui64v(frame.queries.at(index), GL_QUERY_RESULT,
+                            &result);
+    }
+#endif
+    return result;
+  }};
+
+  m_passTimes.clear();
+  m_frameTime = 0.0;
+  for (auto const &pass : frame.passes) {
+    if (!pass.measured) {
+      continue;
+    }
+    auto const milliseconds{
+        m_mode == Mode::Timestamp
+            ? toMilliseconds(getResult(pass.endQuery) -
+                             getResult(pass.beginQuery))
+            : toMilliseconds(getResult(pass.beginQuery))};
+    m_passTimes.push_back({.name = pass.name, .milliseconds = milliseconds});
+    if (m_mode == Mode::TimeElapsed) {
+      m_frameTime += milliseconds;
+    }
+  }
+  if (m_mode == Mode::Timestamp) {
+    m_frameTime =
+        toMilliseconds(getResult(frame.numQueries - 1) - getResult(0));
+  }
+}
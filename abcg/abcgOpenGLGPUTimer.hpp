@@ -0,0 +1,99 @@
+/**
+ * @file abcgOpenGLGPUTimer.hpp
+ * @brief Header file of abcg::OpenGLGPUTimer.
+ *
+ * Declaration of abcg::OpenGLGPUTimer.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_GPU_TIMER_HPP_
+#define ABCG_OPENGL_GPU_TIMER_HPP_
+
+#include "abcgGPUTimer.hpp"
+#include "abcgOpenGLExternal.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace abcg {
+class OpenGLGPUTimer;
+} // namespace abcg
+
+/**
+ * @brief Measures the GPU time of frames and of named passes of a frame using
+ * OpenGL timer queries.
+ *
+ * The queries of each frame are kept in a ring of abcg::OpenGLGPUTimer::
+ * frameLatency frames, so that the results are read a few frames later,
+ * when they are already available, without stalling the pipeline.
+ *
+ * Timestamp queries (`GL_TIMESTAMP`) are used when available. In this case,
+ * passes can be nested. Otherwise, such as in WebGL, `GL_TIME_ELAPSED` queries
+ * are used, passes cannot overlap, and the time of nested passes is not
+ * measured.
+ *
+ * On OpenGL ES and WebGL, the timer requires the `EXT_disjoint_timer_query`
+ * and `EXT_disjoint_timer_query_webgl2` extensions, respectively. If timer
+ * queries are not supported, all functions do nothing.
+ *
+ * @remark All functions must be called with the OpenGL context current.
+ */
+class abcg::OpenGLGPUTimer {
+public:
+  /** @brief Number of frames between issuing the queries of a frame and
+   * reading their results. */
+  static constexpr std::size_t frameLatency{4};
+
+  void create();
+  void destroy();
+  [[nodiscard]] bool isSupported() const noexcept;
+
+  void beginFrame();
+  void endFrame();
+  void beginPass(std::string_view name);
+  void endPass();
+
+  [[nodiscard]] double getFrameTime() const noexcept;
+  [[nodiscard]] std::span<GPUPassTime const> getPassTimes() const noexcept;
+
+private:
+  enum class Mode : std::uint8_t { Unsupported, Timestamp, TimeElapsed };
+
+  struct Pass {
+    std::string name;
+    // Indices of the queries of the pass. In time elapsed mode, only
+    // beginQuery is used
+    std::size_t beginQuery{};
+    std::size_t endQuery{};
+    bool measured{true};
+  };
+
+  struct Frame {
+    std::vector<GLuint> queries;
+    std::size_t numQueries{};
+    std::vector<Pass> passes;
+    bool pending{};
+  };
+
+  [[nodiscard]] std::size_t issueTimestamp(Frame &frame);
+  void collect(Frame &frame);
+
+  Mode m_mode{Mode::Unsupported};
+  bool m_useEXT{};
+  std::array<Frame, frameLatency> m_frames{};
+  std::size_t m_frameIndex{};
+  bool m_inFrame{};
+  std::vector<std::size_t> m_openPasses;
+  double m_frameTime{};
+  std::vector<GPUPassTime> m_passTimes;
+};
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file abcgOpenGLProgramCache.cpp
+ * @brief Definition of functions of the OpenGL program binary cache.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLProgramCache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+
+#include <fmt/core.h>
+#include <gsl/gsl>
+
+#include "abcgOpenGLFunction.hpp"
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::string cacheDirectory;
+
+// Identifies the file format. Change it when the format or the key changes
+constexpr std::array<char, 8> fileMagic{'A', 'B', 'C', 'G',
+                                        'P', 'R', 'G', '1'};
+
+// FNV-1a, which, unlike std::hash, is stable across runs and standard
+// libraries
+class Hasher {
+public:
+  void add(std::span<std::byte const> bytes) noexcept {
+    for (auto const byte : bytes) {
+      m_hash ^= static_cast<std::uint64_t>(byte);
+      m_hash *= 0x100000001b3;
+    }
+  }
+
+  void add(std::string_view text) noexcept {
+    add(std::as_bytes(std::span{text}));
+    // Separate consecutive strings
+    add(std::as_bytes(std::span{"", 1}));
+  }
+
+  [[nodiscard]] std::uint64_t get() const noexcept { return m_hash; }
+
+private:
+  std::uint64_t m_hash{0xcbf29ce484222325};
+};
+
+std::string_view getGLString(GLenum name) {
+  auto const *string{abcg::glGetString(name)};
+  return string == nullptr ? std::string_view{}
+                           : reinterpret_cast<char const *>(string);
+}
+
+bool isProgramBinarySupported() {
+#if defined(__EMSCRIPTEN__)
+  return false;
+#else
+  if (GLEW_VERSION_4_1 != GL_TRUE && GLEW_ARB_get_program_binary != GL_TRUE) {
+    return false;
+  }
+  GLint numFormats{};
+  abcg::glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+  return numFormats > 0;
+#endif
+}
+
+#if !defined(__EMSCRIPTEN__)
+bool isProgramBinaryFormatSupported(GLenum format) {
+  GLint numFormats{};
+  abcg::glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+  std::vector<GLint> formats(gsl::narrow<std::size_t>(numFormats));
+  abcg::glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+  return std::ranges::find(formats, gsl::narrow<GLint>(format)) !=
+         formats.end();
+}
+#endif
+
+std::filesystem::path getFilePath(std::uint64_t key) {
+  return std::filesystem::path{cacheDirectory} /
+         fmt::format("{:016x}.bin", key);
+}
+} // namespace
+
+/**
+ * @brief Sets the directory of the program binary cache.
+ *
+ * The directory is created when the first binary is saved.
+ *
+ * @param directory Path of the directory, or an empty string to disable the
+ * cache.
+ */
+void abcg::setOpenGLProgramCacheDirectory(std::string_view directory) {
+  cacheDirectory = directory;
+}
+
+/**
+ * @brief Returns the directory of the program binary cache.
+ *
+ * @return Path of the directory, or an empty string if the cache is disabled.
+ */
+std::string const &abcg::getOpenGLProgramCacheDirectory() noexcept {
+  return cacheDirectory;
+}
+
+/**
+ * @brief Computes the key of a program in the program binary cache.
+ *
+ * @param sources Source codes and stages of the shaders of the program.
+ *
+ * @return Key of the program, or `std::nullopt` if the cache is disabled or
+ * program binaries are not supported by the current context.
+ */
+std::optional<std::uint64_t>
+abcg::getOpenGLProgramCacheKey(std::vector<ShaderSource> const &sources) {
+  if (cacheDirectory.empty() || !isProgramBinarySupported()) {
+    return std::nullopt;
+  }
+
+  Hasher hasher;
+  hasher.add(getGLString(GL_VENDOR));
+  hasher.add(getGLString(GL_RENDERER));
+  hasher.add(getGLString(GL_VERSION));
+  for (auto const &source : sources) {
+    hasher.add(std::as_bytes(std::span{&source.stage, 1}));
+    hasher.add(source.source);
+  }
+  return hasher.get();
+}
+
+/**
+ * @brief Creates a program from a binary of the program binary cache.
+ *
+ * If the driver rejects the binary, the binary is removed from the cache.
+ *
+ * @param key Key returned by abcg::getOpenGLProgramCacheKey.
+ *
+ * @return ID of the linked program object, or 0 if the binary is not in the
+ * cache or was rejected.
+ */
+GLuint abcg::loadOpenGLProgramBinary([[maybe_unused]] std::uint64_t key) {
+#if defined(__EMSCRIPTEN__)
+  return 0;
+#else
+  auto const path{getFilePath(key)};
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    return 0;
+  }
+
+  std::array<char, fileMagic.size()> magic{};
+  GLenum format{};
+  stream.read(magic.data(), magic.size());
+  stream.read(reinterpret_cast<char *>(&format), sizeof(format));
+  std::vector<char> binary{std::istreambuf_iterator<char>{stream}, {}};
+  stream.close();
+
+  std::error_code errorCode;
+  // Binaries of a format no longer supported would fail with GL_INVALID_ENUM
+  if (magic != fileMagic || binary.empty() ||
+      !isProgramBinaryFormatSupported(format)) {
+    std::filesystem::remove(path, errorCode);
+    return 0;
+  }
+
+  auto const program{glCreateProgram()};
+  glProgramBinary(program, format, binary.data(),
+                  gsl::narrow<GLsizei>(binary.size()));
+  GLint linkStatus{};
+  glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+  if (linkStatus == GL_FALSE) {
+    glDeleteProgram(program);
+    std::filesystem::remove(path, errorCode);
+    return 0;
+  }
+  return program;
+#endif
+}
+
+/**
+ * @brief Hints that the binary of a program will be retrieved for the
+ * program binary cache.
+ *
+ * Call this before linking the program.
+ *
+ * @param program ID of the program object.
+ */
+void abcg::setOpenGLProgramBinaryRetrievable(
+    [[maybe_unused]] GLuint program) {
+#if !defined(__EMSCRIPTEN__)
+  glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+}
+
+/**
+ * @brief Saves the binary of a linked program to the program binary cache.
+ *
+ * Failing to save the binary is not an error: a warning is printed and the
+ * program is rebuilt from the sources in the next run.
+ *
+ * @param key Key returned by abcg::getOpenGLProgramCacheKey.
+ * @param program ID of the linked program object.
+ */
+void abcg::saveOpenGLProgramBinary([[maybe_unused]] std::uint64_t key,
+                                   [[maybe_unused]] GLuint program) {
+#if !defined(__EMSCRIPTEN__)
+  GLint length{};
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  std::vector<char> binary(gsl::narrow<std::size_t>(length));
+  GLenum format{};
+  glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+  auto const path{getFilePath(key)};
+  // Write to a temporary file first so that an interrupted write never
+  // leaves a truncated binary in the cache
+  auto temporaryPath{path};
+  temporaryPath += ".tmp";
+  std::error_code errorCode;
+  std::filesystem::create_directories(path.parent_path(), errorCode);
+  {
+    std::ofstream stream(temporaryPath, std::ios::binary);
+    stream.write(fileMagic.data(), fileMagic.size());
+    stream.write(reinterpret_cast<char const *>(&format), sizeof(format));
+    stream.write(binary.data(), gsl::narrow<std::streamsize>(binary.size()));
+    if (!stream) {
+      fmt::print("Warning: failed to write program binary {}\n",
+                 temporaryPath.string());
+      return;
+    }
+  }
+  std::filesystem::rename(temporaryPath, path, errorCode);
+  if (errorCode) {
+    fmt::print("Warning: failed to write program binary {}: {}\n",
+               path.string(), errorCode.message());
+    std::filesystem::remove(temporaryPath, errorCode);
+  }
+#endif
+}
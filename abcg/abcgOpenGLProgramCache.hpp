@@ -0,0 +1,52 @@
+/**
+ * @file abcgOpenGLProgramCache.hpp
+ * @brief Declaration of functions of the OpenGL program binary cache.
+ *
+ * On-disk cache of program binaries used by abcg::createOpenGLProgram.
+ *
+ * When a cache directory is set, abcg::createOpenGLProgram looks up a program
+ * binary saved by a previous run before compiling the shaders, and saves the
+ * binary of each program it links. The binaries are retrieved with
+ * `glGetProgramBinary` and loaded with `glProgramBinary`.
+ *
+ * A binary is keyed by a hash of the shader sources, after being read from
+ * file, their stages, and the OpenGL vendor, renderer and version strings, so
+ * that a driver update never reuses a stale binary. If the driver rejects a
+ * binary nonetheless, the file is deleted and the program is rebuilt from the
+ * sources.
+ *
+ * The cache requires OpenGL 4.1 or `ARB_get_program_binary` and at least one
+ * program binary format. It is not available in WebGL.
+ *
+ * @sa abcg::OpenGLSettings::programCacheDirectory.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_PROGRAM_CACHE_HPP_
+#define ABCG_OPENGL_PROGRAM_CACHE_HPP_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "abcgOpenGLExternal.hpp"
+#include "abcgShader.hpp"
+
+namespace abcg {
+void setOpenGLProgramCacheDirectory(std::string_view directory);
+[[nodiscard]] std::string const &getOpenGLProgramCacheDirectory() noexcept;
+
+[[nodiscard]] std::optional<std::uint64_t>
+getOpenGLProgramCacheKey(std::vector<ShaderSource> const &sources);
+[[nodiscard]] GLuint loadOpenGLProgramBinary(std::uint64_t key);
+void setOpenGLProgramBinaryRetrievable(GLuint program);
+void saveOpenGLProgramBinary(std::uint64_t key, GLuint program);
+} // namespace abcg
+
+#endif
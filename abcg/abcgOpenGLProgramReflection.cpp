@@ -0,0 +1,316 @@
+/**
+ * @file abcgOpenGLProgramReflection.cpp
+ * @brief Definition of abcg::OpenGLProgramReflection members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLProgramReflection.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <utility>
+
+#include <fmt/core.h>
+#include <gsl/gsl>
+
+#include "abcgOpenGLFunction.hpp"
+
+namespace {
+constexpr std::string_view arraySuffix{"[0]"};
+
+// Returns the name without the [0] suffix of arrays, or an empty string if the
+// resource is not an array
+std::string_view arrayAlias(std::string_view name) {
+  if (name.ends_with(arraySuffix)) {
+    return name.substr(0, name.size() - arraySuffix.size());
+  }
+  return {};
+}
+
+// Returns the length of the longest name of a resource type, including the
+// null terminator
+std::size_t maxNameLength(GLuint program, GLenum pname) {
+  GLint length{};
+  abcg::glGetProgramiv(program, pname, &length);
+  return std::max<std::size_t>(1, gsl::narrow<std::size_t>(length));
+}
+
+std::vector<abcg::OpenGLProgramResource> queryAttributes(GLuint program) {
+  GLint numAttributes{};
+  abcg::glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &numAttributes);
+  std::string name(maxNameLength(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH),
+                   '\0');
+
+  std::vector<abcg::OpenGLProgramResource> attributes;
+  attributes.reserve(gsl::narrow<std::size_t>(numAttributes));
+  for (GLuint index{}; index < gsl::narrow<GLuint>(numAttributes); ++index) {
+    GLsizei length{};
+    GLint size{};
+    GLenum type{};
+    abcg::glGetActiveAttrib(program, index,
+                            gsl::narrow<GLsizei>(name.size()), &length, &size,
+                            &type, name.data());
+    std::string attributeName{name.data(),
+                              gsl::narrow<std::size_t>(length)};
+    auto const location{
+        abcg::glGetAttribLocation(program, attributeName.c_str())};
+    // Built-in attributes such as gl_VertexID have no location
+    if (location < 0) {
+      continue;
+    }
+    attributes.push_back({.name = std::move(attributeName),
+                          .location = location,
+                          .type = type,
+                          .size = size});
+  }
+  return attributes;
+}
+
+std::vector<abcg::OpenGLProgramResource> queryUniforms(GLuint program) {
+  GLint numUniforms{};
+  abcg::glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &numUniforms);
+  std::string name(maxNameLength(program, GL_ACTIVE_UNIFORM_MAX_LENGTH), '\0');
+
+  std::vector<abcg::OpenGLProgramResource> uniforms;
+  uniforms.reserve(gsl::narrow<std::size_t>(numUniforms));
+  for (GLuint index{}; index < gsl::narrow<GLuint>(numUniforms); ++index) {
+    GLsizei length{};
+    GLint size{};
+    GLenum type{};
+    abcg::glGetActiveUniform(program, index, gsl::narrow<GLsizei>(name.size()),
+                             &length, &size, &type, name.data());
+    std::string uniformName{name.data(), gsl::narrow<std::size_t>(length)};
+    auto const location{
+        abcg::glGetUniformLocation(program, uniformName.c_str())};
+    // Uniforms of uniform blocks have no location
+    if (location < 0) {
+      continue;
+    }
+    uniforms.push_back({.name = std::move(uniformName),
+                        .location = location,
+                        .type = type,
+                        .size = size});
+  }
+  return uniforms;
+}
+
+// Queries the elements of uniform arrays other than the first (e.g.,
+// "lights[2]"), which are not reported as active uniforms. Their locations are
+// not necessarily consecutive, so each one is queried
+std::vector<abcg::OpenGLProgramResource> queryUniformArrayElements(
+    GLuint program, std::vector<abcg::OpenGLProgramResource> const &uniforms) {
+  std::vector<abcg::OpenGLProgramResource> elements;
+  for (auto const &uniform : uniforms) {
+    auto const arrayName{arrayAlias(uniform.name)};
+    if (arrayName.empty()) {
+      continue;
+    }
+    for (GLint index{1}; index < uniform.size; ++index) {
+      auto elementName{fmt::format("{}[{}]", arrayName, index)};
+      auto const location{
+          abcg::glGetUniformLocation(program, elementName.c_str())};
+      if (location < 0) {
+        continue;
+      }
+      elements.push_back({.name = std::move(elementName),
+                          .location = location,
+                          .type = uniform.type,
+                          .size = 1});
+    }
+  }
+  return elements;
+}
+
+std::vector<abcg::OpenGLProgramResource> queryUniformBlocks(GLuint program) {
+  GLint numBlocks{};
+  abcg::glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &numBlocks);
+  std::string name(
+      maxNameLength(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH), '\0');
+
+  std::vector<abcg::OpenGLProgramResource> blocks;
+  blocks.reserve(gsl::narrow<std::size_t>(numBlocks));
+  for (GLuint index{}; index < gsl::narrow<GLuint>(numBlocks); ++index) {
+    GLsizei length{};
+    abcg::glGetActiveUniformBlockName(program, index,
+                                      gsl::narrow<GLsizei>(name.size()),
+                                      &length, name.data());
+    GLint dataSize{};
+    abcg::glGetActiveUniformBlockiv(program, index, GL_UNIFORM_BLOCK_DATA_SIZE,
+                                    &dataSize);
+    blocks.push_back(
+        {.name = std::string{name.data(), gsl::narrow<std::size_t>(length)},
+         .location = gsl::narrow<GLint>(index),
+         .type = 0,
+         .size = dataSize});
+  }
+  return blocks;
+}
+} // namespace
+
+/**
+ * @brief Queries the active resources of a linked program.
+ *
+ * @param program ID of a linked program object.
+ *
+ * @return Reflection of the program.
+ */
+abcg::OpenGLProgramReflection abcg::reflectOpenGLProgram(GLuint program) {
+  OpenGLProgramReflection reflection;
+  reflection.m_program = program;
+  reflection.m_attributes.build(queryAttributes(program));
+  auto uniforms{queryUniforms(program)};
+  auto elements{queryUniformArrayElements(program, uniforms)};
+  reflection.m_uniforms.build(std::move(uniforms), std::move(elements));
+  reflection.m_uniformBlocks.build(queryUniformBlocks(program));
+  return reflection;
+}
+
+/**
+ * @brief Returns the program object.
+ *
+ * @return ID of the program given to abcg::reflectOpenGLProgram.
+ */
+GLuint abcg::OpenGLProgramReflection::getProgram() const noexcept {
+  return m_program;
+}
+
+/**
+ * @brief Returns the location of an active attribute.
+ *
+ * @param name Name of the attribute.
+ *
+ * @return Location of the attribute, or -1 if the program has no active
+ * attribute with this name.
+ */
+GLint abcg::OpenGLProgramReflection::getAttribLocation(
+    OpenGLResourceName name) const {
+  auto const *attribute{m_attributes.find(name)};
+  return attribute == nullptr ? -1 : attribute->location;
+}
+
+/**
+ * @brief Returns the location of an active uniform.
+ *
+ * @param name Name of the uniform, or of an element of a uniform array (e.g.,
+ * `lights[2]`).
+ *
+ * @return Location of the uniform, or -1 if the program has no active uniform
+ * with this name outside uniform blocks.
+ */
+GLint abcg::OpenGLProgramReflection::getUniformLocation(
+    OpenGLResourceName name) const {
+  auto const *uniform{m_uniforms.find(name)};
+  return uniform == nullptr ? -1 : uniform->location;
+}
+
+/**
+ * @brief Returns the index of an active uniform block.
+ *
+ * @param name Name of the uniform block.
+ *
+ * @return Index of the uniform block, or `GL_INVALID_INDEX` if the program has
+ * no active uniform block with this name.
+ */
+GLuint abcg::OpenGLProgramReflection::getUniformBlockIndex(
+    OpenGLResourceName name) const {
+  auto const *block{m_uniformBlocks.find(name)};
+  return block == nullptr ? GL_INVALID_INDEX
+                          : gsl::narrow<GLuint>(block->location);
+}
+
+/**
+ * @brief Returns the active attributes.
+ *
+ * @return Active attributes in the order reported by OpenGL.
+ */
+std::span<abcg::OpenGLProgramResource const>
+abcg::OpenGLProgramReflection::getAttributes() const noexcept {
+  return m_attributes.getResources();
+}
+
+/**
+ * @brief Returns the active uniforms that are not in uniform blocks.
+ *
+ * @return Active uniforms in the order reported by OpenGL.
+ */
+std::span<abcg::OpenGLProgramResource const>
+abcg::OpenGLProgramReflection::getUniforms() const noexcept {
+  return m_uniforms.getResources();
+}
+
+/**
+ * @brief Returns the active uniform blocks.
+ *
+ * @return Active uniform blocks in the order of their indices.
+ */
+std::span<abcg::OpenGLProgramResource const>
+abcg::OpenGLProgramReflection::getUniformBlocks() const noexcept {
+  return m_uniformBlocks.getResources();
+}
+
+void abcg::OpenGLProgramReflection::Table::build(
+    std::vector<OpenGLProgramResource> resources,
+    std::vector<OpenGLProgramResource> elements) {
+  // Elements are stored after the resources, so that they can be found but
+  // are not returned by getResources
+  m_numResources = resources.size();
+  m_resources = std::move(resources);
+  m_resources.insert(m_resources.end(),
+                     std::make_move_iterator(elements.begin()),
+                     std::make_move_iterator(elements.end()));
+
+  // Keep the load factor at or below 50%, counting the array aliases
+  m_slots.assign(std::bit_ceil(std::max<std::size_t>(
+                     4, 4 * m_resources.size())),
+                 Slot{});
+  for (std::size_t index{}; index < m_resources.size(); ++index) {
+    std::string_view const name{m_resources[index].name};
+    insert(OpenGLResourceName::hashName(name), index);
+    if (auto const alias{arrayAlias(name)}; !alias.empty()) {
+      insert(OpenGLResourceName::hashName(alias), index);
+    }
+  }
+}
+
+abcg::OpenGLProgramResource const *
+abcg::OpenGLProgramReflection::Table::find(OpenGLResourceName name) const {
+  if (m_slots.empty()) {
+    return nullptr;
+  }
+  auto const mask{m_slots.size() - 1};
+  for (auto position{gsl::narrow_cast<std::size_t>(name.hash) & mask};;
+       position = (position + 1) & mask) {
+    auto const &slot{m_slots[position]};
+    if (slot.index == 0) {
+      return nullptr;
+    }
+    if (slot.hash != name.hash) {
+      continue;
+    }
+    auto const &resource{m_resources[slot.index - 1]};
+    if (resource.name == name.name || arrayAlias(resource.name) == name.name) {
+      return &resource;
+    }
+  }
+}
+
+std::span<abcg::OpenGLProgramResource const>
+abcg::OpenGLProgramReflection::Table::getResources() const noexcept {
+  return std::span{m_resources}.first(m_numResources);
+}
+
+void abcg::OpenGLProgramReflection::Table::insert(std::uint64_t hash,
+                                                  std::size_t index) {
+  auto const mask{m_slots.size() - 1};
+  auto position{gsl::narrow_cast<std::size_t>(hash) & mask};
+  while (m_slots[position].index != 0) {
+    position = (position + 1) & mask;
+  }
+  m_slots[position] = {.hash = hash,
+                       .index = gsl::narrow<std::uint32_t>(index + 1)};
+}
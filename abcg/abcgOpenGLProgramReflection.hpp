@@ -0,0 +1,163 @@
+/**
+ * @file abcgOpenGLProgramReflection.hpp
+ * @brief Header file of abcg::OpenGLProgramReflection.
+ *
+ * Declaration of abcg::OpenGLProgramReflection.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_PROGRAM_REFLECTION_HPP_
+#define ABCG_OPENGL_PROGRAM_REFLECTION_HPP_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "abcgOpenGLExternal.hpp"
+
+namespace abcg {
+class OpenGLProgramReflection;
+struct OpenGLProgramResource;
+struct OpenGLResourceName;
+
+[[nodiscard]] OpenGLProgramReflection reflectOpenGLProgram(GLuint program);
+} // namespace abcg
+
+/**
+ * @brief Name of a program resource and its hash value.
+ *
+ * Names given as string literals are hashed at compile time:
+ *
+ * @code
+ * auto const location{reflection.getUniformLocation("modelMatrix")};
+ * @endcode
+ *
+ * Names known only at run time must be converted explicitly:
+ *
+ * @code
+ * auto const location{
+ *     reflection.getUniformLocation(abcg::OpenGLResourceName{name})};
+ * @endcode
+ */
+struct abcg::OpenGLResourceName {
+  /** @brief Name of the resource. */
+  std::string_view name;
+  /** @brief FNV-1a hash value of the name. */
+  std::uint64_t hash{};
+
+  /**
+   * @brief Constructs a name from a string literal, hashed at compile time.
+   */
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  consteval OpenGLResourceName(char const *resourceName)
+      : name{resourceName}, hash{hashName(resourceName)} {}
+
+  /**
+   * @brief Constructs a name from a string, hashed at run time.
+   */
+  constexpr explicit OpenGLResourceName(std::string_view resourceName)
+      : name{resourceName}, hash{hashName(resourceName)} {}
+
+  /**
+   * @brief Returns the FNV-1a hash value of a name.
+   */
+  static constexpr std::uint64_t hashName(std::string_view name) {
+    std::uint64_t hash{0xcbf29ce484222325};
+    for (auto const character : name) {
+      hash ^= static_cast<std::uint8_t>(character);
+      hash *= 0x100000001b3;
+    }
+    return hash;
+  }
+};
+
+/**
+ * @brief Active attribute, uniform or uniform block of a program.
+ */
+struct abcg::OpenGLProgramResource {
+  /** @brief Name of the resource. */
+  std::string name;
+  /** @brief Location of the attribute or uniform, or index of the uniform
+   * block. */
+  GLint location{-1};
+  /** @brief Data type (e.g., `GL_FLOAT_VEC3`) of the attribute or uniform, or
+   * zero for uniform blocks. */
+  GLenum type{};
+  /** @brief Number of array elements of the attribute or uniform, or data size
+   * in bytes of the uniform block. */
+  GLint size{};
+};
+
+/**
+ * @brief Active attributes, uniforms and uniform blocks of a linked program.
+ *
+ * The resources are queried once by abcg::reflectOpenGLProgram and stored in
+ * flat hash tables indexed by the hash value of their names. Lookups are
+ * resolved without calling OpenGL, and the hash value of names given as
+ * string literals is computed at compile time (see abcg::OpenGLResourceName).
+ *
+ * Uniforms of uniform blocks have no location and are not included. Arrays of
+ * attributes and uniforms can be looked up with or without the `[0]` suffix,
+ * as in `glGetUniformLocation`. The locations of the other elements of
+ * uniform arrays (e.g., `lights[2]`) are also queried by
+ * abcg::reflectOpenGLProgram, but elements of attribute arrays are not.
+ *
+ * The reflection can also be filled by abcg::createOpenGLProgram and
+ * abcg::checkOpenGLShaderLink.
+ */
+class abcg::OpenGLProgramReflection {
+public:
+  [[nodiscard]] GLuint getProgram() const noexcept;
+
+  [[nodiscard]] GLint getAttribLocation(OpenGLResourceName name) const;
+  [[nodiscard]] GLint getUniformLocation(OpenGLResourceName name) const;
+  [[nodiscard]] GLuint getUniformBlockIndex(OpenGLResourceName name) const;
+
+  [[nodiscard]] std::span<OpenGLProgramResource const>
+  getAttributes() const noexcept;
+  [[nodiscard]] std::span<OpenGLProgramResource const>
+  getUniforms() const noexcept;
+  [[nodiscard]] std::span<OpenGLProgramResource const>
+  getUniformBlocks() const noexcept;
+
+private:
+  friend OpenGLProgramReflection abcg::reflectOpenGLProgram(GLuint program);
+
+  // Open addressing hash table of resources
+  class Table {
+  public:
+    void build(std::vector<OpenGLProgramResource> resources,
+               std::vector<OpenGLProgramResource> elements = {});
+    [[nodiscard]] OpenGLProgramResource const *
+    find(OpenGLResourceName name) const;
+    [[nodiscard]] std::span<OpenGLProgramResource const>
+    getResources() const noexcept;
+
+  private:
+    struct Slot {
+      std::uint64_t hash{};
+      // Index of the resource in m_resources plus one, or zero if empty
+      std::uint32_t index{};
+    };
+
+    void insert(std::uint64_t hash, std::size_t index);
+
+    // Resources followed by the array elements that are only looked up
+    std::vector<OpenGLProgramResource> m_resources;
+    std::size_t m_numResources{};
+    std::vector<Slot> m_slots;
+  };
+
+  GLuint m_program{};
+  Table m_attributes;
+  Table m_uniforms;
+  Table m_uniformBlocks;
+};
+
+#endif
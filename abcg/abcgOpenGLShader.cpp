@@ -10,17 +10,19 @@
 
 #include "abcgOpenGLShader.hpp"
 
+#if defined(__EMSCRIPTEN__)
+#include <GLES2/gl2ext.h>
+#endif
+
 #include <cppitertools/itertools.hpp>
 #include <fmt/core.h>
 #include <gsl/gsl>
 
-#include <filesystem>
-#include <fstream>
 #include <regex>
-#include <sstream>
 #include <vector>
 
 #include "abcgException.hpp"
+#include "abcgOpenGLProgramCache.hpp"
 
 namespace {
 void printShaderInfoLog(GLuint const shader, std::string_view prefix) {
@@ -77,23 +79,6 @@ void printProgramInfoLog(GLuint const program) {
   }
 }
 
-// If filenameOrText is a filename, returns the contents of the file (assumed
-// to be in text format). Otherwise, returns the filename.
-[[nodiscard]] std::string toSource(std::string_view filenameOrText) {
-  static const std::size_t maxPathSize{260};
-  std::string str{filenameOrText};
-  if (str.size() > maxPathSize || !std::filesystem::exists(str)) {
-    return str;
-  }
-  std::ifstream stream(str);
-  if (!stream) {
-    throw abcg::RuntimeError(fmt::format("Failed to read file {}", str));
-  }
-  std::stringstream source;
-  source << stream.rdbuf();
-  return source.str();
-}
-
 // Compiles a shader and returns immediately (i.e. don't wait until completion).
 // Returns the shader ID of the compiled shader.
 [[nodiscard]] abcg::OpenGLShader compileHelper(std::string_view shaderSource,
@@ -156,9 +141,15 @@ void deleteShaders(std::vector<abcg::OpenGLShader> const &shaderIDs) {
 /**
  * @brief Creates a program object from a group of shader paths or source codes.
  *
+ * If a program binary cache directory is set (see
+ * abcg::setOpenGLProgramCacheDirectory), the program is loaded from a binary
+ * saved by a previous run when possible, and its binary is saved otherwise.
+ *
  * @param pathsOrSources Paths or source codes of the shaders to be compiled and
  * linked to the program.
  * @param throwOnError Whether to throw exceptions on compile/link errors.
+ * @param reflection If not null, receives the active attributes, uniforms and
+ * uniform blocks of the program, as returned by abcg::reflectOpenGLProgram.
  *
  * @throw abcg::RuntimeError if the shader could not be read from file, or if
  * the program could not be created, or if the compilation of any shader has
@@ -168,12 +159,24 @@ void deleteShaders(std::vector<abcg::OpenGLShader> const &shaderIDs) {
  */
 GLuint
 abcg::createOpenGLProgram(std::vector<ShaderSource> const &pathsOrSources,
-                          bool throwOnError) {
+                          bool throwOnError,
+                          OpenGLProgramReflection *reflection) {
   std::vector<ShaderSource> sources;
   sources.reserve(pathsOrSources.size());
   for (auto const &pathOrSource : pathsOrSources) {
-    sources.push_back(
-        {.source = toSource(pathOrSource.source), .stage = pathOrSource.stage});
+    sources.push_back({.source = readShaderSource(pathOrSource.source),
+                       .stage = pathOrSource.stage});
+  }
+
+  auto const cacheKey{getOpenGLProgramCacheKey(sources)};
+  if (cacheKey.has_value()) {
+    if (auto const cachedProgram{loadOpenGLProgramBinary(*cacheKey)};
+        cachedProgram != 0) {
+      if (reflection != nullptr) {
+        *reflection = reflectOpenGLProgram(cachedProgram);
+      }
+      return cachedProgram;
+    }
   }
 
   std::vector<OpenGLShader> compiledShaders;
@@ -200,6 +203,9 @@ abcg::createOpenGLProgram(std::vector<ShaderSource> const &pathsOrSources,
     glAttachShader(shaderProgram, shader.shader);
   }
 
+  if (cacheKey.has_value()) {
+    setOpenGLProgramBinaryRetrievable(shaderProgram);
+  }
   glLinkProgram(shaderProgram);
 
   for (auto const &shader : compiledShaders) {
@@ -220,6 +226,14 @@ abcg::createOpenGLProgram(std::vector<ShaderSource> const &pathsOrSources,
     return 0U;
   }
 
+  if (cacheKey.has_value()) {
+    saveOpenGLProgramBinary(*cacheKey, shaderProgram);
+  }
+
+  if (reflection != nullptr) {
+    *reflection = reflectOpenGLProgram(shaderProgram);
+  }
+
   return shaderProgram;
 }
 
@@ -251,8 +265,8 @@ std::vector<abcg::OpenGLShader> abcg::triggerOpenGLShaderCompile(
   std::vector<ShaderSource> sources;
   sources.reserve(pathsOrSources.size());
   for (auto const &pathOrSource : pathsOrSources) {
-    sources.push_back(
-        {.source = toSource(pathOrSource.source), .stage = pathOrSource.stage});
+    sources.push_back({.source = readShaderSource(pathOrSource.source),
+                       .stage = pathOrSource.stage});
   }
 
   std::vector<OpenGLShader> compiledShaders;
@@ -269,7 +283,8 @@ std::vector<abcg::OpenGLShader> abcg::triggerOpenGLShaderCompile(
  * @brief Queries the compile status of shader objects.
  *
  * This should be called after abcg::triggerOpenGLShaderCompile. The function
- * waits until all shaders are compiled.
+ * waits until all shaders are compiled. Use abcg::pollOpenGLShaderCompile to
+ * find out whether the compilation has finished without waiting.
  *
  * @param shaders Shader objects returned by abcg::triggerOpenGLShaderCompile.
  * @param throwOnError Whether to throw exceptions on compile errors.
@@ -347,17 +362,22 @@ GLuint abcg::triggerOpenGLShaderLink(std::vector<OpenGLShader> const &shaders,
  * @brief Queries the link status of the shaders attached to a program object.
  *
  * This should be called after abcg::triggerOpenGLShaderLink. The function will
- * wait until all shaders are linked.
+ * wait until all shaders are linked. Use abcg::pollOpenGLShaderLink to find out
+ * whether the linking has finished without waiting.
  *
  * @param shaderProgram ID of the shader program returned by
  * abcg::triggerOpenGLShaderLink.
  * @param throwOnError Whether to throw exceptions on link error.
+ * @param reflection If not null and the shaders linked with success, receives
+ * the active attributes, uniforms and uniform blocks of the program, as
+ * returned by abcg::reflectOpenGLProgram.
  *
  * @throw abcg::RuntimeError if program linking failed.
  *
  * @return `true` if the shaders linked with success; `false` otherwise.
  */
-bool abcg::checkOpenGLShaderLink(GLuint shaderProgram, bool throwOnError) {
+bool abcg::checkOpenGLShaderLink(GLuint shaderProgram, bool throwOnError,
+                                 OpenGLProgramReflection *reflection) {
   GLint linkStatus{};
   glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linkStatus);
   if (linkStatus == GL_FALSE) {
@@ -371,5 +391,125 @@ bool abcg::checkOpenGLShaderLink(GLuint shaderProgram, bool throwOnError) {
     return false;
   }
 
+  if (reflection != nullptr) {
+    *reflection = reflectOpenGLProgram(shaderProgram);
+  }
+
   return true;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Returns whether the driver can compile shaders and link programs in
+ * background threads and report their completion without blocking.
+ *
+ * This requires `KHR_parallel_shader_compile` or
+ * `ARB_parallel_shader_compile`.
+ *
+ * @return `true` if `GL_COMPLETION_STATUS_KHR` can be queried; `false`
+ * otherwise.
+ */
+bool abcg::isParallelShaderCompileSupported() {
+#if defined(__EMSCRIPTEN__)
+  return emscripten_webgl_enable_extension(
+             emscripten_webgl_get_current_context(),
+             "KHR_parallel_shader_compile") == EM_TRUE;
+#else
+  return GLEW_KHR_parallel_shader_compile == GL_TRUE ||
+         GLEW_ARB_parallel_shader_compile == GL_TRUE;
+#endif
+}
+
+/**
+ * @brief Sets the number of background threads the driver can use for
+ * compiling shaders and linking programs.
+ *
+ * Some drivers only compile in parallel after this is called. Does nothing if
+ * parallel shader compilation is not supported, or in WebGL, where the number
+ * of threads is chosen by the browser.
+ *
+ * @param count Number of threads. `0xFFFFFFFF` lets the driver choose.
+ *
+ * @sa abcg::isParallelShaderCompileSupported.
+ */
+void abcg::setMaxShaderCompilerThreads([[maybe_unused]] GLuint count) {
+#if !defined(__EMSCRIPTEN__)
+  if (GLEW_KHR_parallel_shader_compile == GL_TRUE) {
+    glMaxShaderCompilerThreadsKHR(count);
+  } else if (GLEW_ARB_parallel_shader_compile == GL_TRUE) {
+    glMaxShaderCompilerThreadsARB(count);
+  }
+#endif
+}
+
+/**
+ * @brief Queries whether the compilation of shader objects has finished,
+ * without waiting for it when possible.
+ *
+ * If parallel shader compilation is supported, the status is
+ * abcg::OpenGLBuildStatus::Pending while any shader is being compiled.
+ * Otherwise, the function waits until all shaders are compiled.
+ *
+ * When the status is no longer abcg::OpenGLBuildStatus::Pending, call
+ * abcg::checkOpenGLShaderCompile, which then returns without waiting, to print
+ * the information log and delete the shaders on error.
+ *
+ * @param shaders Shader objects returned by abcg::triggerOpenGLShaderCompile.
+ * @param parallelCompile Value returned by
+ * abcg::isParallelShaderCompileSupported for the current context. Query it
+ * once instead of before each poll, as it may be expensive (e.g., in WebGL).
+ *
+ * @return Status of the compilation.
+ */
+abcg::OpenGLBuildStatus
+abcg::pollOpenGLShaderCompile(std::vector<OpenGLShader> const &shaders,
+                              bool parallelCompile) {
+  if (parallelCompile) {
+    for (auto const &shader : shaders) {
+      GLint completionStatus{};
+      glGetShaderiv(shader.shader, GL_COMPLETION_STATUS_KHR, &completionStatus);
+      if (completionStatus == GL_FALSE) {
+        return OpenGLBuildStatus::Pending;
+      }
+    }
+  }
+
+  for (auto const &shader : shaders) {
+    GLint compileStatus{};
+    glGetShaderiv(shader.shader, GL_COMPILE_STATUS, &compileStatus);
+    if (compileStatus == GL_FALSE) {
+      return OpenGLBuildStatus::Failed;
+    }
+  }
+  return OpenGLBuildStatus::Ready;
+}
+
+/**
+ * @brief Queries whether the linking of a program object has finished,
+ * without waiting for it when possible.
+ *
+ * This is the counterpart of abcg::pollOpenGLShaderCompile for
+ * abcg::triggerOpenGLShaderLink. When the status is no longer
+ * abcg::OpenGLBuildStatus::Pending, call abcg::checkOpenGLShaderLink.
+ *
+ * @param shaderProgram ID of the shader program returned by
+ * abcg::triggerOpenGLShaderLink.
+ * @param parallelCompile Value returned by
+ * abcg::isParallelShaderCompileSupported for the current context.
+ *
+ * @return Status of the linking.
+ */
+abcg::OpenGLBuildStatus abcg::pollOpenGLShaderLink(GLuint shaderProgram,
+                                                   bool parallelCompile) {
+  if (parallelCompile) {
+    GLint completionStatus{};
+    glGetProgramiv(shaderProgram, GL_COMPLETION_STATUS_KHR, &completionStatus);
+    if (completionStatus == GL_FALSE) {
+      return OpenGLBuildStatus::Pending;
+    }
+  }
+
+  GLint linkStatus{};
+  glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linkStatus);
+  return linkStatus == GL_FALSE ? OpenGLBuildStatus::Failed
+                                : OpenGLBuildStatus::Ready;
+}
@@ -12,13 +12,16 @@
 #define ABCG_OPENGL_SHADER_HPP_
 
 #include "abcgOpenGLExternal.hpp"
+#include "abcgOpenGLProgramReflection.hpp"
 #include "abcgShader.hpp"
 
+#include <cstdint>
 #include <vector>
 
 namespace abcg {
 struct OpenGLShader;
-}
+enum class OpenGLBuildStatus : std::uint8_t;
+} // namespace abcg
 
 /**
  * @brief OpenGL shader object and its corresponding stage.
@@ -30,17 +33,42 @@ struct abcg::OpenGLShader {
   GLuint stage{};
 };
 
+/**
+ * @brief Status of an asynchronous shader compile or program link.
+ *
+ * @sa abcg::pollOpenGLShaderCompile.
+ * @sa abcg::pollOpenGLShaderLink.
+ */
+enum class abcg::OpenGLBuildStatus : std::uint8_t {
+  /** @brief The driver is still compiling or linking. */
+  Pending,
+  /** @brief Compiled or linked with success. */
+  Ready,
+  /** @brief Failed to compile or link. */
+  Failed
+};
+
 namespace abcg {
 [[nodiscard]] GLuint
 createOpenGLProgram(std::vector<ShaderSource> const &pathsOrSources,
-                    bool throwOnError = true);
+                    bool throwOnError = true,
+                    OpenGLProgramReflection *reflection = nullptr);
 [[nodiscard]] std::vector<abcg::OpenGLShader>
 triggerOpenGLShaderCompile(std::vector<ShaderSource> const &pathsOrSources);
 bool checkOpenGLShaderCompile(std::vector<OpenGLShader> const &shaders,
                               bool throwOnError = true);
 GLuint triggerOpenGLShaderLink(std::vector<OpenGLShader> const &shaders,
                                bool throwOnError = true);
-bool checkOpenGLShaderLink(GLuint shaderProgram, bool throwOnError = true);
+bool checkOpenGLShaderLink(GLuint shaderProgram, bool throwOnError = true,
+                           OpenGLProgramReflection *reflection = nullptr);
+
+[[nodiscard]] bool isParallelShaderCompileSupported();
+void setMaxShaderCompilerThreads(GLuint count);
+[[nodiscard]] OpenGLBuildStatus
+pollOpenGLShaderCompile(std::vector<OpenGLShader> const &shaders,
+                        bool parallelCompile);
+[[nodiscard]] OpenGLBuildStatus pollOpenGLShaderLink(GLuint shaderProgram,
+                                                     bool parallelCompile);
 } // namespace abcg
 
 #endif
@@ -0,0 +1,110 @@
+/**
+ * @file abcgOpenGLShaderHotReload.cpp
+ * @brief Definition of abcg::OpenGLShaderHotReload members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLShaderHotReload.hpp"
+
+#include <algorithm>
+
+#include <fmt/core.h>
+
+#include "abcgException.hpp"
+#include "abcgOpenGLFunction.hpp"
+
+/**
+ * @brief Registers a program to be rebuilt when its shader files change.
+ *
+ * @param program ID of the program object built from @a pathsOrSources, e.g.,
+ * by abcg::createOpenGLProgram.
+ * @param pathsOrSources Paths or source codes of the shaders of the program.
+ * Only paths of existing files are watched.
+ * @param onReload Function called after the program is replaced.
+ *
+ * @return Index of the entry of the program.
+ */
+std::size_t
+abcg::OpenGLShaderHotReload::add(GLuint program,
+                                 std::vector<ShaderSource> pathsOrSources,
+                                 ReloadCallback onReload) {
+  for (auto const &pathOrSource : pathsOrSources) {
+    m_watcher.watch(pathOrSource.source);
+  }
+  m_entries.push_back({.sources = std::move(pathsOrSources),
+                       .program = program,
+                       .onReload = std::move(onReload),
+                       .build = std::nullopt,
+                       .changed = false});
+  return m_entries.size() - 1;
+}
+
+/**
+ * @brief Starts rebuilding the programs whose files changed and replaces the
+ * programs whose rebuild has finished.
+ *
+ * Call this with the OpenGL context current, at a frame boundary.
+ */
+void abcg::OpenGLShaderHotReload::update() {
+  for (auto const &path : m_watcher.poll()) {
+    for (auto &entry : m_entries) {
+      if (std::ranges::find(entry.sources, path, &ShaderSource::source) !=
+          entry.sources.end()) {
+        entry.changed = true;
+      }
+    }
+  }
+
+  for (auto &entry : m_entries) {
+    if (entry.changed && !entry.build.has_value()) {
+      entry.changed = false;
+      entry.build = m_buildQueue.add(entry.sources);
+    }
+  }
+
+  try {
+    m_buildQueue.update();
+  } catch (abcg::Exception const &exception) {
+    // The build is marked as failed and is handled below
+    fmt::print("{}", exception.what());
+  }
+
+  for (auto &entry : m_entries) {
+    if (!entry.build.has_value()) {
+      continue;
+    }
+    auto const status{m_buildQueue.getStatus(*entry.build)};
+    if (status == OpenGLBuildStatus::Pending) {
+      continue;
+    }
+    if (status == OpenGLBuildStatus::Ready) {
+      auto const previousProgram{entry.program};
+      entry.program = m_buildQueue.getProgram(*entry.build);
+      if (entry.onReload) {
+        entry.onReload(entry.program);
+      }
+      glDeleteProgram(previousProgram);
+    } else {
+      fmt::print("Failed to reload program {}; keeping the previous one\n",
+                 entry.program);
+    }
+    // Reuse the build for the next change instead of growing the queue
+    m_buildQueue.release(*entry.build);
+    entry.build.reset();
+  }
+}
+
+/**
+ * @brief Returns the current program of an entry.
+ *
+ * @param entry Index returned by abcg::OpenGLShaderHotReload::add.
+ *
+ * @return ID of the last program built with success.
+ */
+GLuint abcg::OpenGLShaderHotReload::getProgram(std::size_t entry) const {
+  return m_entries.at(entry).program;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file abcgOpenGLShaderHotReload.hpp
+ * @brief Header file of abcg::OpenGLShaderHotReload.
+ *
+ * Declaration of abcg::OpenGLShaderHotReload.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_SHADER_HOT_RELOAD_HPP_
+#define ABCG_OPENGL_SHADER_HOT_RELOAD_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "abcgOpenGLBuildQueue.hpp"
+#include "abcgOpenGLExternal.hpp"
+#include "abcgShader.hpp"
+#include "abcgShaderFileWatcher.hpp"
+
+namespace abcg {
+class OpenGLShaderHotReload;
+} // namespace abcg
+
+/**
+ * @brief Rebuilds programs when their shader files change.
+ *
+ * Programs registered with abcg::OpenGLShaderHotReload::add are rebuilt
+ * through an abcg::OpenGLBuildQueue whenever an abcg::ShaderFileWatcher
+ * reports a change to any of their shader files. The rebuilt program replaces
+ * the previous one only in abcg::OpenGLShaderHotReload::update, so call it
+ * once per frame at the start of abcg::OpenGLWindow::onPaint. If the new
+ * shaders fail to compile or link, the error is printed and the previous
+ * program is kept.
+ *
+ * @code
+ * // In onCreate
+ * std::vector<abcg::ShaderSource> const sources{
+ *     {.source = "shader.vert", .stage = abcg::ShaderStage::Vertex},
+ *     {.source = "shader.frag", .stage = abcg::ShaderStage::Fragment}};
+ * m_program = abcg::createOpenGLProgram(sources);
+ * m_hotReload.add(m_program, sources,
+ *                 [this](GLuint program) { m_program = program; });
+ *
+ * // In onPaint
+ * m_hotReload.update();
+ * @endcode
+ *
+ * The previous program is deleted after the callback returns. Uniform
+ * locations and other program state queried by the application must be
+ * queried again in the callback.
+ */
+class abcg::OpenGLShaderHotReload {
+public:
+  /** @brief Function called after a program is replaced, with the new
+   * program. */
+  using ReloadCallback = std::function<void(GLuint program)>;
+
+  std::size_t add(GLuint program, std::vector<ShaderSource> pathsOrSources,
+                  ReloadCallback onReload = {});
+  void update();
+
+  [[nodiscard]] GLuint getProgram(std::size_t entry) const;
+
+private:
+  struct Entry {
+    std::vector<ShaderSource> sources;
+    GLuint program{};
+    ReloadCallback onReload;
+    // Index of the rebuild in m_buildQueue, if any
+    std::optional<std::size_t> build;
+    // Whether a file changed since the last rebuild was started
+    bool changed{};
+  };
+
+  ShaderFileWatcher m_watcher;
+  OpenGLBuildQueue m_buildQueue;
+  std::vector<Entry> m_entries;
+};
+
+#endif
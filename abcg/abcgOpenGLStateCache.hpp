@@ -0,0 +1,268 @@
+/**
+ * @file abcgOpenGLStateCache.hpp
+ * @brief Header file of abcg::OpenGLStateCache.
+ *
+ * Declaration and definition of abcg::OpenGLStateCache.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_STATE_CACHE_HPP_
+#define ABCG_OPENGL_STATE_CACHE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+
+#include "abcgOpenGLExternal.hpp"
+
+namespace abcg {
+class OpenGLStateCache;
+} // namespace abcg
+
+/**
+ * @brief Shadow copy of the OpenGL object bindings of the current context,
+ * used for skipping redundant binds.
+ *
+ * When `ABCG_GL_STATE_CACHE` is defined (see the `ENABLE_GL_STATE_CACHE` CMake
+ * option), the wrappers of `glBindBuffer`, `glUseProgram`,
+ * `glBindVertexArray`, `glActiveTexture` and `glBindTexture` defined in
+ * abcgOpenGLFunction.hpp do not call OpenGL if the object is already bound,
+ * according to the cache of the calling thread (abcg::glStateCache). The
+ * wrappers of `glBindBufferBase`, `glBindBufferRange` and the `glDelete*`
+ * functions of these objects keep the cache up to date.
+ *
+ * The cache only knows about the calls made through the wrappers. After
+ * changing these bindings in any other way, e.g., by calling OpenGL functions
+ * of the global namespace or by using another library, call
+ * abcg::invalidateGLStateCache. abcg::OpenGLWindow invalidates the cache
+ * whenever it makes its context current and after rendering the Dear ImGui
+ * controls.
+ *
+ * Bindings of buffer targets and texture targets not tracked by the cache are
+ * never skipped.
+ */
+class abcg::OpenGLStateCache {
+public:
+  /** @brief Value of a binding whose object is not known. */
+  static constexpr GLuint unknown{~GLuint{}};
+  /** @brief Number of texture units tracked by the cache. */
+  static constexpr std::size_t maxTextureUnits{32};
+
+  /**
+   * @brief Marks all bindings as unknown.
+   */
+  void invalidate() noexcept { *this = OpenGLStateCache{}; }
+
+  /**
+   * @brief Records a `glBindBuffer` call.
+   *
+   * @return `true` if the buffer is already bound and the call can be
+   * skipped.
+   */
+  [[nodiscard]] bool bindBuffer(GLenum target, GLuint buffer) noexcept {
+    auto const index{bufferIndex(target)};
+    return index.has_value() && update(m_buffers.at(*index), buffer);
+  }
+
+  /**
+   * @brief Records a `glBindBufferBase` or `glBindBufferRange` call, which
+   * also bind the buffer to the generic binding point of @a target.
+   */
+  void bindBufferBase(GLenum target, GLuint buffer) noexcept {
+    if (auto const index{bufferIndex(target)}) {
+      m_buffers.at(*index) = buffer;
+    }
+  }
+
+  /**
+   * @brief Records a `glUseProgram` call.
+   *
+   * @return `true` if the program is already in use and the call can be
+   * skipped.
+   */
+  [[nodiscard]] bool useProgram(GLuint program) noexcept {
+    return update(m_program, program);
+  }
+
+  /**
+   * @brief Records a `glBindVertexArray` call.
+   *
+   * @return `true` if the vertex array is already bound and the call can be
+   * skipped.
+   */
+  [[nodiscard]] bool bindVertexArray(GLuint vertexArray) noexcept {
+    if (update(m_vertexArray, vertexArray)) {
+      return true;
+    }
+    // The element array buffer binding is part of the vertex array state
+    m_buffers.at(elementArrayBufferIndex) = unknown;
+    return false;
+  }
+
+  /**
+   * @brief Records a `glActiveTexture` call.
+   *
+   * @return `true` if the texture unit is already active and the call can be
+   * skipped.
+   */
+  [[nodiscard]] bool activeTexture(GLenum texture) noexcept {
+    auto const unit{static_cast<std::size_t>(texture - GL_TEXTURE0)};
+    return update(m_activeTexture,
+                  unit < maxTextureUnits ? static_cast<GLuint>(unit) : unknown);
+  }
+
+  /**
+   * @brief Records a `glBindTexture` call.
+   *
+   * @return `true` if the texture is already bound to the active texture unit
+   * and the call can be skipped.
+   */
+  [[nodiscard]] bool bindTexture(GLenum target, GLuint texture) noexcept {
+    auto const index{textureIndex(target)};
+    return m_activeTexture != unknown && index.has_value() &&
+           update(m_textures.at(m_activeTexture).at(*index), texture);
+  }
+
+  /**
+   * @brief Records a `glDeleteBuffers` call.
+   */
+  void deleteBuffers(std::span<GLuint const> buffers) noexcept {
+    for (auto const buffer : buffers) {
+      forget(m_buffers, buffer);
+    }
+  }
+
+  /**
+   * @brief Records a `glDeleteProgram` call.
+   */
+  void deleteProgram(GLuint program) noexcept {
+    if (m_program == program) {
+      m_program = unknown;
+    }
+  }
+
+  /**
+   * @brief Records a `glDeleteVertexArrays` call.
+   */
+  void deleteVertexArrays(std::span<GLuint const> vertexArrays) noexcept {
+    for (auto const vertexArray : vertexArrays) {
+      if (m_vertexArray == vertexArray) {
+        m_vertexArray = unknown;
+        m_buffers.at(elementArrayBufferIndex) = unknown;
+      }
+    }
+  }
+
+  /**
+   * @brief Records a `glDeleteTextures` call.
+   */
+  void deleteTextures(std::span<GLuint const> textures) noexcept {
+    for (auto const texture : textures) {
+      for (auto &unit : m_textures) {
+        forget(unit, texture);
+      }
+    }
+  }
+
+private:
+  static constexpr std::array bufferTargets{
+      GLenum{GL_ARRAY_BUFFER},       GLenum{GL_ELEMENT_ARRAY_BUFFER},
+      GLenum{GL_UNIFORM_BUFFER},     GLenum{GL_COPY_READ_BUFFER},
+      GLenum{GL_COPY_WRITE_BUFFER},  GLenum{GL_PIXEL_PACK_BUFFER},
+      GLenum{GL_PIXEL_UNPACK_BUFFER}, GLenum{GL_TRANSFORM_FEEDBACK_BUFFER}};
+  static constexpr std::size_t elementArrayBufferIndex{1};
+  static constexpr std::array textureTargets{
+      GLenum{GL_TEXTURE_2D}, GLenum{GL_TEXTURE_CUBE_MAP}, GLenum{GL_TEXTURE_3D},
+      GLenum{GL_TEXTURE_2D_ARRAY}};
+
+  template <std::size_t N>
+  static std::optional<std::size_t>
+  indexOf(std::array<GLenum, N> const &targets, GLenum target) noexcept {
+    for (std::size_t index{}; index < N; ++index) {
+      if (targets[index] == target) {
+        return index;
+      }
+    }
+    return std::nullopt;
+  }
+
+  static std::optional<std::size_t> bufferIndex(GLenum target) noexcept {
+    return indexOf(bufferTargets, target);
+  }
+
+  static std::optional<std::size_t> textureIndex(GLenum target) noexcept {
+    return indexOf(textureTargets, target);
+  }
+
+  // Sets binding to object. Returns true if it was already set. An unknown
+  // object is never considered set, so the call is always forwarded
+  static bool update(GLuint &binding, GLuint object) noexcept {
+    if (object != unknown && binding == object) {
+      return true;
+    }
+    binding = object;
+    return false;
+  }
+
+  // Marks the bindings of a deleted object as unknown
+  template <std::size_t N>
+  static void forget(std::array<GLuint, N> &bindings, GLuint object) noexcept {
+    for (auto &binding : bindings) {
+      if (binding == object) {
+        binding = unknown;
+      }
+    }
+  }
+
+  template <std::size_t N>
+  static constexpr std::array<GLuint, N> makeUnknownBindings() noexcept {
+    std::array<GLuint, N> bindings{};
+    bindings.fill(unknown);
+    return bindings;
+  }
+
+  std::array<GLuint, bufferTargets.size()> m_buffers{
+      makeUnknownBindings<bufferTargets.size()>()};
+  // Bindings of each texture target of each texture unit
+  std::array<std::array<GLuint, textureTargets.size()>, maxTextureUnits>
+      m_textures{[] {
+        std::array<std::array<GLuint, textureTargets.size()>, maxTextureUnits>
+            textures{};
+        textures.fill(makeUnknownBindings<textureTargets.size()>());
+        return textures;
+      }()};
+  GLuint m_program{unknown};
+  GLuint m_vertexArray{unknown};
+  // Index of the active texture unit
+  GLuint m_activeTexture{unknown};
+};
+
+namespace abcg {
+#if defined(ABCG_GL_STATE_CACHE)
+/** @brief State cache of the calling thread. */
+inline thread_local OpenGLStateCache glStateCache{};
+#endif
+
+/**
+ * @brief Marks all bindings of the state cache of the calling thread as
+ * unknown.
+ *
+ * Call this after changing the bindings of buffers, programs, vertex arrays
+ * or textures without using the OpenGL function wrappers. Does nothing if
+ * `ABCG_GL_STATE_CACHE` is not defined.
+ *
+ * @sa abcg::OpenGLStateCache.
+ */
+inline void invalidateGLStateCache() noexcept {
+#if defined(ABCG_GL_STATE_CACHE)
+  glStateCache.invalidate();
+#endif
+}
+} // namespace abcg
+
+#endif
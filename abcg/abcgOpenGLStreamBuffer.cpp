@@ -0,0 +1,258 @@
+/**
+ * @file abcgOpenGLStreamBuffer.cpp
+ * @brief Definition of abcg::OpenGLStreamBuffer members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLStreamBuffer.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <fmt/core.h>
+#include <gsl/gsl>
+
+#include "abcgException.hpp"
+#include "abcgOpenGLFunction.hpp"
+
+namespace {
+// Time to wait for the fence of a region in each call to glClientWaitSync, in
+// nanoseconds
+constexpr GLuint64 fenceTimeout{1'000'000};
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+/**
+ * @brief Creates the buffer object.
+ *
+ * @param target Target to which the buffer is bound, e.g. `GL_ARRAY_BUFFER`
+ * or `GL_UNIFORM_BUFFER`.
+ * @param regionSize Maximum number of bytes written in a frame. The size of
+ * the buffer is abcg::OpenGLStreamBuffer::numRegions times this value.
+ *
+ * @throw abcg::RuntimeError if the buffer cannot be persistently mapped.
+ */
+void abcg::OpenGLStreamBuffer::create(GLenum target, std::size_t regionSize) {
+  destroy();
+
+  m_target = target;
+  m_regionSize = regionSize;
+  m_minAlignment = 1;
+  if (target == GL_UNIFORM_BUFFER) {
+    GLint offsetAlignment{};
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    m_minAlignment = std::max<std::size_t>(
+        1, gsl::narrow<std::size_t>(offsetAlignment));
+  }
+  // Keep each region aligned
+  m_regionSize = alignUp(m_regionSize, m_minAlignment);
+  auto const bufferSize{gsl::narrow<GLsizeiptr>(m_regionSize * numRegions)};
+
+  glGenBuffers(1, &m_buffer);
+  glBindBuffer(m_target, m_buffer);
+
+#if !defined(__EMSCRIPTEN__)
+  if (GLEW_VERSION_4_4 == GL_TRUE || GLEW_ARB_buffer_storage == GL_TRUE) {
+    GLbitfield const flags{GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                           GL_MAP_COHERENT_BIT};
+    ::glBufferStorage(m_target, bufferSize, nullptr, flags);
+    m_persistentData = static_cast<std::byte *>(
+        glMapBufferRange(m_target, 0, bufferSize, flags));
+    if (m_persistentData == nullptr) {
+      glBindBuffer(m_target, 0);
+      destroy();
+      throw abcg::RuntimeError("Failed to map stream buffer");
+    }
+  } else
+#endif
+  {
+    glBufferData(m_target, bufferSize, nullptr, GL_STREAM_DRAW);
+  }
+
+  glBindBuffer(m_target, 0);
+}
+
+/**
+ * @brief Destroys the buffer object and its fences.
+ */
+void abcg::OpenGLStreamBuffer::destroy() {
+  for (auto &fence : m_fences) {
+    if (fence != nullptr) {
+      abcg::glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+  // Deleting the buffer also unmaps it
+  glDeleteBuffers(1, &m_buffer);
+  m_buffer = 0;
+  m_persistentData = nullptr;
+  m_region = 0;
+  m_regionOffset = 0;
+  m_mapped = false;
+}
+
+/**
+ * @brief Starts writing the data of a new frame.
+ *
+ * Moves to the next region and, if the GPU may still be reading it, waits for
+ * the fence inserted by abcg::OpenGLStreamBuffer::endFrame when the region was
+ * last used.
+ */
+void abcg::OpenGLStreamBuffer::beginFrame() {
+  m_region = (m_region + 1) % numRegions;
+  m_regionOffset = 0;
+
+  auto &fence{m_fences.at(m_region)};
+  if (fence == nullptr) {
+    return;
+  }
+#if defined(__EMSCRIPTEN__)
+  // WebGL does not allow waiting on the client. Mapped ranges are written
+  // with bufferSubData when unmapped, which is already synchronized
+#else
+  while (true) {
+    auto const status{abcg::glClientWaitSync(
+        fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout)};
+    if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+      break;
+    }
+    if (status == GL_WAIT_FAILED) {
+      throw abcg::RuntimeError("Failed to wait for stream buffer fence");
+    }
+  }
+#endif
+  abcg::glDeleteSync(fence);
+  fence = nullptr;
+}
+
+/**
+ * @brief Finishes writing the data of the current frame.
+ *
+ * Inserts a fence that is signaled when the GPU has finished executing the
+ * commands issued so far, i.e., when the region of the frame can be reused.
+ * Call this after the draw calls that use the data of the frame.
+ */
+void abcg::OpenGLStreamBuffer::endFrame() {
+  auto &fence{m_fences.at(m_region)};
+  if (fence != nullptr) {
+    abcg::glDeleteSync(fence);
+  }
+  fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ * @brief Reserves memory in the region of the current frame and maps it for
+ * writing.
+ *
+ * The buffer is left bound to its target. Call abcg::OpenGLStreamBuffer::unmap
+ * after writing the data and before using the buffer in draw calls.
+ *
+ * @param size Number of bytes to reserve.
+ * @param alignment Alignment of the offset of the memory, in bytes. For
+ * uniform buffers, the offset is also aligned to
+ * `GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT`.
+ *
+ * @return Mapped memory and its offset in the buffer.
+ *
+ * @throw abcg::RuntimeError if there is not enough free space in the region
+ * or if the memory cannot be mapped.
+ */
+abcg::OpenGLStreamAllocation
+abcg::OpenGLStreamBuffer::map(std::size_t size, std::size_t alignment) {
+  auto const regionOffset{
+      alignUp(m_regionOffset, std::max(alignment, m_minAlignment))};
+  if (regionOffset + size > m_regionSize) {
+    throw abcg::RuntimeError(
+        fmt::format("Stream buffer region overflow ({} of {} bytes)",
+                    regionOffset + size, m_regionSize));
+  }
+  m_regionOffset = regionOffset + size;
+  auto const offset{m_region * m_regionSize + regionOffset};
+
+  glBindBuffer(m_target, m_buffer);
+  std::byte *data{};
+  if (m_persistentData != nullptr) {
+    data = std::next(m_persistentData, gsl::narrow<std::ptrdiff_t>(offset));
+  } else {
+    // The range is not in use by the GPU, as guaranteed by the fence
+    data = static_cast<std::byte *>(glMapBufferRange(
+        m_target, gsl::narrow<GLintptr>(offset), gsl::narrow<GLsizeiptr>(size),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+            GL_MAP_UNSYNCHRONIZED_BIT));
+    if (data == nullptr) {
+      throw abcg::RuntimeError("Failed to map stream buffer range");
+    }
+    m_mapped = true;
+  }
+  return {.data = {data, size}, .offset = gsl::narrow<GLintptr>(offset)};
+}
+
+/**
+ * @brief Finishes writing the memory returned by the last call to
+ * abcg::OpenGLStreamBuffer::map.
+ *
+ * The buffer must still be bound to its target.
+ */
+void abcg::OpenGLStreamBuffer::unmap() {
+  if (m_mapped) {
+    glUnmapBuffer(m_target);
+    m_mapped = false;
+  }
+}
+
+/**
+ * @brief Copies data to the region of the current frame.
+ *
+ * This is the same as calling abcg::OpenGLStreamBuffer::map, copying the data
+ * and calling abcg::OpenGLStreamBuffer::unmap.
+ *
+ * @param data Data to be copied.
+ * @param alignment Alignment of the offset of the data, in bytes.
+ *
+ * @return Offset of the data in the buffer.
+ *
+ * @throw abcg::RuntimeError if there is not enough free space in the region.
+ */
+GLintptr abcg::OpenGLStreamBuffer::upload(std::span<std::byte const> data,
+                                          std::size_t alignment) {
+  auto const allocation{map(data.size(), alignment)};
+  std::ranges::copy(data, allocation.data.begin());
+  unmap();
+  return allocation.offset;
+}
+
+/**
+ * @brief Returns the buffer object.
+ *
+ * @return Name of the buffer object.
+ */
+GLuint abcg::OpenGLStreamBuffer::getBuffer() const noexcept {
+  return m_buffer;
+}
+
+/**
+ * @brief Returns the target of the buffer.
+ *
+ * @return Target given in abcg::OpenGLStreamBuffer::create.
+ */
+GLenum abcg::OpenGLStreamBuffer::getTarget() const noexcept {
+  return m_target;
+}
+
+/**
+ * @brief Returns whether the buffer is persistently mapped.
+ *
+ * @return `true` if the buffer was created with `glBufferStorage` and is
+ * persistently mapped, `false` if ranges are mapped with `glMapBufferRange` on
+ * each call to abcg::OpenGLStreamBuffer::map.
+ */
+bool abcg::OpenGLStreamBuffer::isPersistent() const noexcept {
+  return m_persistentData != nullptr;
+}
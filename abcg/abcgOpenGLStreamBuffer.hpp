@@ -0,0 +1,105 @@
+/**
+ * @file abcgOpenGLStreamBuffer.hpp
+ * @brief Header file of abcg::OpenGLStreamBuffer.
+ *
+ * Declaration of abcg::OpenGLStreamBuffer.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_STREAM_BUFFER_HPP_
+#define ABCG_OPENGL_STREAM_BUFFER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "abcgOpenGLExternal.hpp"
+
+namespace abcg {
+class OpenGLStreamBuffer;
+struct OpenGLStreamAllocation;
+} // namespace abcg
+
+/**
+ * @brief Memory of an abcg::OpenGLStreamBuffer where data can be written.
+ *
+ * @sa abcg::OpenGLStreamBuffer::map.
+ */
+struct abcg::OpenGLStreamAllocation {
+  /** @brief Mapped memory, valid until abcg::OpenGLStreamBuffer::unmap is
+   * called. */
+  std::span<std::byte> data;
+  /** @brief Offset of the memory from the start of the buffer, in bytes. */
+  GLintptr offset{};
+};
+
+/**
+ * @brief Buffer object for streaming per-frame dynamic data, such as vertices
+ * and uniform blocks, without stalling.
+ *
+ * The buffer is split into abcg::OpenGLStreamBuffer::numRegions regions, one
+ * for each frame in flight. Each frame writes only to its own region, and a
+ * fence inserted at the end of the frame tells when the GPU has finished
+ * reading it, so the region can be reused a few frames later. The fence is
+ * normally already signaled when the region is reused, so writes never wait
+ * for the GPU.
+ *
+ * If `glBufferStorage` is available (OpenGL 4.4 or `ARB_buffer_storage`), the
+ * buffer is persistently and coherently mapped once and abcg::
+ * OpenGLStreamBuffer::map returns a pointer into the mapping. Otherwise, such
+ * as in OpenGL ES 3.0 and WebGL 2.0, each call to abcg::OpenGLStreamBuffer::map
+ * maps the requested range with `glMapBufferRange`, using the
+ * `GL_MAP_INVALIDATE_RANGE_BIT` and `GL_MAP_UNSYNCHRONIZED_BIT` flags, and
+ * abcg::OpenGLStreamBuffer::unmap unmaps it.
+ *
+ * Typical use in abcg::OpenGLWindow::onPaint:
+ *
+ * @code
+ * m_streamBuffer.beginFrame();
+ * auto const allocation{m_streamBuffer.map(sizeof(vertices))};
+ * std::memcpy(allocation.data.data(), vertices.data(), sizeof(vertices));
+ * m_streamBuffer.unmap();
+ * // Draw using the data at allocation.offset
+ * m_streamBuffer.endFrame();
+ * @endcode
+ *
+ * @remark All functions must be called with the OpenGL context current.
+ */
+class abcg::OpenGLStreamBuffer {
+public:
+  /** @brief Number of regions, i.e., of frames whose data can be in flight. */
+  static constexpr std::size_t numRegions{3};
+
+  void create(GLenum target, std::size_t regionSize);
+  void destroy();
+
+  void beginFrame();
+  void endFrame();
+
+  [[nodiscard]] OpenGLStreamAllocation map(std::size_t size,
+                                           std::size_t alignment = 4);
+  void unmap();
+  GLintptr upload(std::span<std::byte const> data, std::size_t alignment = 4);
+
+  [[nodiscard]] GLuint getBuffer() const noexcept;
+  [[nodiscard]] GLenum getTarget() const noexcept;
+  [[nodiscard]] bool isPersistent() const noexcept;
+
+private:
+  GLuint m_buffer{};
+  GLenum m_target{};
+  std::size_t m_regionSize{};
+  std::size_t m_minAlignment{1};
+  std::byte *m_persistentData{};
+  std::array<GLsync, numRegions> m_fences{};
+  std::size_t m_region{};
+  // Offset of the free space in the current region, relative to its start
+  std::size_t m_regionOffset{};
+  bool m_mapped{};
+};
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file abcgOpenGLUniformBuffer.cpp
+ * @brief Definition of abcg::OpenGLUniformBuffer members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgOpenGLUniformBuffer.hpp"
+
+#include <string>
+
+#include <gsl/gsl>
+
+#include "abcgOpenGLFunction.hpp"
+
+/**
+ * @brief Sets the uniform buffer binding point of a uniform block of a
+ * program.
+ *
+ * Does nothing if the program has no active uniform block with the given
+ * name.
+ *
+ * @param program Program object.
+ * @param blockName Name of the uniform block.
+ * @param bindingPoint Uniform buffer binding point.
+ */
+void abcg::bindUniformBlock(GLuint program, std::string_view blockName,
+                            GLuint bindingPoint) {
+  auto const blockIndex{
+      glGetUniformBlockIndex(program, std::string{blockName}.c_str())};
+  if (blockIndex != GL_INVALID_INDEX) {
+    glUniformBlockBinding(program, blockIndex, bindingPoint);
+  }
+}
+
+/**
+ * @brief Creates the uniform buffer.
+ *
+ * @param frameSize Maximum number of bytes of the uniform blocks bound in a
+ * frame, including the padding required by
+ * `GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT` between blocks.
+ */
+void abcg::OpenGLUniformBuffer::create(std::size_t frameSize) {
+  m_streamBuffer.create(GL_UNIFORM_BUFFER, frameSize);
+}
+
+/**
+ * @brief Destroys the uniform buffer.
+ */
+void abcg::OpenGLUniformBuffer::destroy() { m_streamBuffer.destroy(); }
+
+/**
+ * @brief Starts binding the uniform blocks of a new frame.
+ *
+ * @sa abcg::OpenGLStreamBuffer::beginFrame.
+ */
+void abcg::OpenGLUniformBuffer::beginFrame() { m_streamBuffer.beginFrame(); }
+
+/**
+ * @brief Finishes binding the uniform blocks of the current frame.
+ *
+ * Call this after the draw calls that use the uniform blocks.
+ *
+ * @sa abcg::OpenGLStreamBuffer::endFrame.
+ */
+void abcg::OpenGLUniformBuffer::endFrame() { m_streamBuffer.endFrame(); }
+
+/**
+ * @brief Returns the buffer object.
+ *
+ * @return Name of the buffer object.
+ */
+GLuint abcg::OpenGLUniformBuffer::getBuffer() const noexcept {
+  return m_streamBuffer.getBuffer();
+}
+
+void abcg::OpenGLUniformBuffer::bindRange(GLuint bindingPoint, GLintptr offset,
+                                          std::size_t size) {
+  m_streamBuffer.unmap();
+  glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint,
+                    m_streamBuffer.getBuffer(), offset,
+                    gsl::narrow<GLsizeiptr>(size));
+}
@@ -0,0 +1,90 @@
+/**
+ * @file abcgOpenGLUniformBuffer.hpp
+ * @brief Header file of abcg::OpenGLUniformBuffer.
+ *
+ * Declaration of abcg::OpenGLUniformBuffer.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_OPENGL_UNIFORM_BUFFER_HPP_
+#define ABCG_OPENGL_UNIFORM_BUFFER_HPP_
+
+#include <cstddef>
+#include <string_view>
+
+#include "abcgOpenGLExternal.hpp"
+#include "abcgOpenGLStreamBuffer.hpp"
+#include "abcgStd140.hpp"
+
+namespace abcg {
+class OpenGLUniformBuffer;
+
+void bindUniformBlock(GLuint program, std::string_view blockName,
+                      GLuint bindingPoint);
+} // namespace abcg
+
+/**
+ * @brief Shared uniform buffer for uploading std140 uniform blocks.
+ *
+ * Each call to abcg::OpenGLUniformBuffer::bind writes a uniform block to a new
+ * range of an abcg::OpenGLStreamBuffer and binds the range to a uniform buffer
+ * binding point with `glBindBufferRange`. This replaces the `glUniform*` calls
+ * of each uniform of an object with a single range bind.
+ *
+ * The blocks are C++ structs described by abcg::Std140Members. For instance,
+ * with the `Material` struct of the example of abcg::Std140Members:
+ *
+ * @code
+ * // In onCreate
+ * m_uniformBuffer.create(64 * 1024);
+ * abcg::bindUniformBlock(m_program, "Material", 0);
+ *
+ * // In onPaint
+ * m_uniformBuffer.beginFrame();
+ * for (auto const &object : m_objects) {
+ *   m_uniformBuffer.bind(0, object.material);
+ *   // Draw object...
+ * }
+ * m_uniformBuffer.endFrame();
+ * @endcode
+ *
+ * @remark All functions must be called with the OpenGL context current.
+ */
+class abcg::OpenGLUniformBuffer {
+public:
+  void create(std::size_t frameSize);
+  void destroy();
+
+  void beginFrame();
+  void endFrame();
+
+  /**
+   * @brief Writes a uniform block and binds it to a binding point.
+   *
+   * @tparam T Struct described by abcg::Std140Members.
+   *
+   * @param bindingPoint Uniform buffer binding point.
+   * @param block Values of the uniform block.
+   *
+   * @throw abcg::RuntimeError if the blocks written in the current frame do
+   * not fit in the size given in abcg::OpenGLUniformBuffer::create.
+   */
+  template <typename T> void bind(GLuint bindingPoint, T const &block) {
+    auto const allocation{m_streamBuffer.map(std140Size<T>)};
+    writeStd140(block, allocation.data);
+    bindRange(bindingPoint, allocation.offset, std140Size<T>);
+  }
+
+  [[nodiscard]] GLuint getBuffer() const noexcept;
+
+private:
+  void bindRange(GLuint bindingPoint, GLintptr offset, std::size_t size);
+
+  OpenGLStreamBuffer m_streamBuffer;
+};
+
+#endif
@@ -10,6 +10,8 @@
 
 #include "abcgOpenGLWindow.hpp"
 
+#include <ranges>
+
 #include <SDL_events.h>
 #include <SDL_image.h>
 #include <imgui_impl_opengl3.h>
@@ -17,8 +19,40 @@
 
 #include "abcgEmbeddedFonts.hpp"
 #include "abcgException.hpp"
+#include "abcgOpenGLProgramCache.hpp"
+#include "abcgProfiler.hpp"
 #include "abcgWindow.hpp"
 
+#if defined(ABCG_GL_CALL_COUNTERS)
+namespace {
+// Appends the OpenGL call statistics to the FPS counter window
+void paintGLCallStatisticsUI(abcg::OpenGLCallStatistics const &statistics) {
+  // Number of functions listed, by decreasing number of calls
+  constexpr std::ptrdiff_t maxFunctions{5};
+
+  ImGui::Begin("FPS");
+  ImGui::TextUnformatted(fmt::format("GL {} calls, {} draws, {} binds",
+                                     statistics.calls, statistics.draws,
+                                     statistics.binds)
+                             .c_str());
+  ImGui::TextUnformatted(fmt::format("{} uniforms, {} state changes",
+                                     statistics.uniforms,
+                                     statistics.stateChanges)
+                             .c_str());
+  ImGui::TextUnformatted(
+      fmt::format("{} buffer uploads ({:.1f} KiB)", statistics.bufferUploads,
+                  static_cast<double>(statistics.bufferUploadBytes) / 1024.0)
+          .c_str());
+  for (auto const &function :
+       statistics.functions | std::views::take(maxFunctions)) {
+    ImGui::TextUnformatted(
+        fmt::format("  {}: {}", function.name, function.calls).c_str());
+  }
+  ImGui::End();
+}
+} // namespace
+#endif
+
 /**
  * @brief Returns the configuration settings of the OpenGL context.
  *
@@ -77,6 +111,80 @@ void abcg::OpenGLWindow::saveScreenshotPNG(std::string const &filename) const {
   }
 }
 
+/**
+ * @brief Returns the GPU time of a recent frame.
+ *
+ * The time is measured with OpenGL timer queries whose results are read a few
+ * frames later, so it refers to a frame painted up to
+ * abcg::OpenGLGPUTimer::frameLatency frames ago.
+ *
+ * @return GPU time, in milliseconds, or zero if it is not available, e.g., if
+ * abcg::OpenGLSettings::gpuTimerQueries is `false` or timer queries are not
+ * supported.
+ *
+ * @sa abcg::OpenGLGPUTimer::getFrameTime.
+ */
+double abcg::OpenGLWindow::getGPUFrameTime() const noexcept {
+  return m_GPUTimer.getFrameTime();
+}
+
+/**
+ * @brief Returns the GPU time of the passes of a recent frame.
+ *
+ * Passes are measured between calls to abcg::OpenGLWindow::beginGPUPass and
+ * abcg::OpenGLWindow::endGPUPass. The rendering of the Dear ImGui controls is
+ * measured as a pass named "Dear ImGui".
+ *
+ * @return GPU time of each pass of the frame whose time is returned by
+ * abcg::OpenGLWindow::getGPUFrameTime.
+ */
+std::span<abcg::GPUPassTime const>
+abcg::OpenGLWindow::getGPUPassTimes() const noexcept {
+  return m_GPUTimer.getPassTimes();
+}
+
+/**
+ * @brief Returns the number of OpenGL calls of the previous frame.
+ *
+ * The calls are counted by the OpenGL function wrappers of the `abcg`
+ * namespace (e.g. abcg::glDrawArrays) only if ABCg is built with the
+ * `ENABLE_GL_CALL_COUNTERS` CMake option. Calls made through the global
+ * namespace, such as those made by Dear ImGui, are not counted.
+ *
+ * @return Calls issued from the end of the frame before the previous one to
+ * the end of the previous frame, including calls made outside
+ * abcg::OpenGLWindow::onPaint. If there is more than one window, calls of the
+ * other windows in this interval are also included. The statistics are empty
+ * if calls are not counted.
+ *
+ * @sa abcg::OpenGLCallCounter.
+ */
+abcg::OpenGLCallStatistics const &
+abcg::OpenGLWindow::getGLCallStatistics() const noexcept {
+  return m_GLCallStatistics;
+}
+
+/**
+ * @brief Starts measuring the GPU time of a named pass.
+ *
+ * Call this in abcg::OpenGLWindow::onPaint before the OpenGL commands of the
+ * pass, and call abcg::OpenGLWindow::endGPUPass after them. The results are
+ * available a few frames later through abcg::OpenGLWindow::getGPUPassTimes.
+ *
+ * @param name Name of the pass.
+ *
+ * @remark On WebGL, passes cannot be nested. Nested passes are not measured.
+ */
+void abcg::OpenGLWindow::beginGPUPass(std::string_view name) {
+  m_GPUTimer.beginPass(name);
+}
+
+/**
+ * @brief Finishes measuring the GPU time of the pass started by the last
+ * unmatched call to abcg::OpenGLWindow::beginGPUPass.
+ */
+void abcg::OpenGLWindow::endGPUPass() { m_GPUTimer.endPass(); }
+
 /**
  * @brief Custom event handler.
  *
@@ -126,37 +234,19 @@ void abcg::OpenGLWindow::onPaint() {
  *
  * This is not called when the window is minimized.
  *
- * Override it for custom behavior. By default, it shows a FPS counter if
+ * Override it for custom behavior. By default, it shows a FPS counter with
+ * frame time statistics (see abcg::Window::paintFrameStatisticsUI) and, if
+ * calls are counted, the OpenGL call statistics of the previous frame, if
  * abcg::WindowSettings::showFPS is set to `true`, and a toggle fullscreen
  * button if abcg::WindowSettings::showFullscreenButton is set to `true`.
  */
 void abcg::OpenGLWindow::onPaintUI() {
   // FPS counter
   if (abcg::Window::getWindowSettings().showFPS) {
-    auto fps{ImGui::GetIO().Framerate};
-
-    static auto offset{0UL};
-    static auto refreshTime{ImGui::GetTime()};
-    static std::array<float, 150> frames{};
-
-    while (refreshTime < ImGui::GetTime()) {
-      auto const refreshFrequency{60.0};
-      frames.at(offset) = fps;
-      offset = (offset + 1) % frames.size();
-      refreshTime += (1.0 / refreshFrequency);
-    }
-
-    ImGui::SetNextWindowPos(ImVec2(5, 5));
-    ImGui::Begin("FPS", nullptr,
-                 ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs |
-                     ImGuiWindowFlags_NoBringToFrontOnFocus |
-                     ImGuiWindowFlags_NoFocusOnAppearing);
-    auto const label{fmt::format("avg {:.1f} FPS", fps)};
-    ImGui::PlotLines("", frames.data(), gsl::narrow<int>(frames.size()),
-                     gsl::narrow<int>(offset), label.c_str(), 0.0f,
-                     *std::ranges::max_element(frames) * 2,
-                     ImVec2(gsl::narrow<float>(frames.size()), 50));
-    ImGui::End();
+    abcg::Window::paintFrameStatisticsUI();
+#if defined(ABCG_GL_CALL_COUNTERS)
+    paintGLCallStatisticsUI(m_GLCallStatistics);
+#endif
   }
 
   // Fullscreen button
@@ -209,10 +299,46 @@ void abcg::OpenGLWindow::onResize([[maybe_unused]] glm::ivec2 const &size) {}
  * This virtual function is called just before abcg::VulkanWindow::onPaint, even
  * if the window is minimized.
  *
+ * If abcg::WindowSettings::pipelinedUpdate is `true`, this is called on a
+ * worker thread and updates the next frame while the current frame is
+ * rendered. In this case, it must not call graphics API functions.
+ *
  * Override it for custom behavior. By default, it does nothing.
  */
 void abcg::OpenGLWindow::onUpdate() {}
 
+/**
+ * @brief Custom handler for fixed-timestep updates.
+ *
+ * This virtual function is called zero or more times per frame, just before
+ * abcg::OpenGLWindow::onUpdate, when abcg::WindowSettings::fixedDeltaTime is
+ * greater than zero. Use it for simulations that must advance with a constant
+ * time step, such as physics. Use abcg::Window::getInterpolationFactor to
+ * interpolate the simulation state when rendering.
+ *
+ * @param deltaTime Fixed time step, in seconds.
+ *
+ * Override it for custom behavior. By default, it does nothing.
+ */
+void abcg::OpenGLWindow::onFixedUpdate([[maybe_unused]] double deltaTime) {}
+
+/**
+ * @brief Custom handler for handing off the updated state to the renderer.
+ *
+ * This virtual function is called on the main thread for each frame, after
+ * abcg::OpenGLWindow::onUpdate has finished and before
+ * abcg::OpenGLWindow::onPaint.
+ *
+ * If abcg::WindowSettings::pipelinedUpdate is `true`,
+ * abcg::OpenGLWindow::onUpdate runs on a worker thread concurrently with the
+ * paint handlers. In this case, keep separate copies of the simulation state
+ * and the render state, and copy or swap them here, where no update is
+ * running.
+ *
+ * Override it for custom behavior. By default, it does nothing.
+ */
+void abcg::OpenGLWindow::onHandoff() {}
+
 /**
  * @brief Custom handler for cleaning up OpenGL resources.
  *
@@ -227,6 +353,9 @@ void abcg::OpenGLWindow::handleEvent(SDL_Event const &event) {
     return;
   }
 
+  // Event handlers may issue OpenGL commands
+  makeContextCurrent();
+
   if (event.type == SDL_WINDOWEVENT) {
     switch (event.window.event) {
     case SDL_WINDOWEVENT_HIDDEN:
@@ -318,6 +447,16 @@ void abcg::OpenGLWindow::create() {
     break;
   }
 
+#if !defined(NDEBUG) && !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+  // KHR_debug messages may not be generated in a non-debug context
+  if (m_openGLSettings.debugOutput) {
+    int contextFlags{};
+    SDL_GL_GetAttribute(SDL_GL_CONTEXT_FLAGS, &contextFlags);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS,
+                        contextFlags | SDL_GL_CONTEXT_DEBUG_FLAG);
+  }
+#endif
+
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, majorVersion);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, minorVersion);
   SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER,
@@ -350,25 +489,43 @@ void abcg::OpenGLWindow::create() {
   if (abcg::Window::getSDLWindow() == nullptr) {
     throw abcg::SDLError("SDL_CreateWindow failed");
   }
+  markStartupPhase("SDL window");
+
+  // Share objects with the context of the window created before, if any
+  SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT,
+                      SDL_GL_GetCurrentContext() != nullptr ? 1 : 0);
 
   // Create OpenGL context
   m_GLContext = SDL_GL_CreateContext(abcg::Window::getSDLWindow());
   if (m_GLContext == nullptr) {
     throw abcg::SDLError("SDL_GL_CreateContext failed");
   }
+  invalidateGLStateCache();
 
 #if !defined(__EMSCRIPTEN__)
   SDL_GL_SetSwapInterval(m_openGLSettings.vSync ? 1 : 0);
 #endif
+  markStartupPhase("OpenGL context");
 
 #if !defined(__EMSCRIPTEN__)
-  if (auto const err{glewInit()}; GLEW_OK != err) {
+  auto err{glewInit()};
+#if defined(GLEW_ERROR_NO_GLX_DISPLAY)
+  // GLX builds of GLEW fail to find a GLX display in headless mode, whose
+  // context is an EGL pbuffer, but only after the OpenGL entry points are
+  // already loaded
+  if (abcg::Window::getWindowSettings().headless &&
+      err == GLEW_ERROR_NO_GLX_DISPLAY) {
+    err = GLEW_OK;
+  }
+#endif
+  if (GLEW_OK != err) {
     throw abcg::Exception{
         fmt::format("Failed to initialize OpenGL loader: {}",
                     reinterpret_cast<char const *>(glewGetErrorString(err)))};
   }
   fmt::print("Using GLEW.....: {}\n",
              reinterpret_cast<char const *>(glewGetString(GLEW_VERSION)));
+  markStartupPhase("glewInit");
 #endif
 
   fmt::print("OpenGL vendor..: {}\n",
@@ -381,6 +538,17 @@ void abcg::OpenGLWindow::create() {
       "GLSL version...: {}\n",
       reinterpret_cast<char const *>(glGetString(GL_SHADING_LANGUAGE_VERSION)));
 
+#if !defined(NDEBUG) && !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+  if (m_openGLSettings.debugOutput) {
+    m_debugOutput = enableGLDebugOutput();
+    fmt::print("Error checking.: {}\n",
+               m_debugOutput ? "KHR_debug" : "glGetError");
+  } else {
+    // Another context of this thread may have enabled the callback
+    glDebugState.enabled = false;
+  }
+#endif
+
   // Print out extensions
   // GLint numExtensions{};
   // glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
@@ -391,8 +559,6 @@ void abcg::OpenGLWindow::create() {
   // }
 
   // Setup Dear ImGui context
-  IMGUI_CHECKVERSION();
-  ImGui::CreateContext();
   ImGuiIO &guiIO{ImGui::GetIO()};
   // Enable keyboard controls
   guiIO.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
@@ -419,20 +585,50 @@ void abcg::OpenGLWindow::create() {
                                         &fontConfig) == nullptr) {
     throw abcg::RuntimeError("Failed to load font file");
   }
+  markStartupPhase("Dear ImGui");
+
+  if (m_openGLSettings.gpuTimerQueries) {
+    m_GPUTimer.create();
+  }
+
+  // The cache directory is shared by all windows, so an empty setting must not
+  // disable a cache enabled by another window
+  if (!m_openGLSettings.programCacheDirectory.empty()) {
+    setOpenGLProgramCacheDirectory(m_openGLSettings.programCacheDirectory);
+  }
 
   onCreate();
+  markStartupPhase("onCreate");
 
   onResize(getWindowSize());
 }
 
-void abcg::OpenGLWindow::paint() {
-  onUpdate();
+void abcg::OpenGLWindow::fixedUpdate(double deltaTime) {
+  onFixedUpdate(deltaTime);
+}
 
-  if (m_hidden || m_minimized) {
+void abcg::OpenGLWindow::update() { onUpdate(); }
+
+// Makes the context of this window current in the calling thread
+void abcg::OpenGLWindow::makeContextCurrent() {
+  SDL_GL_MakeCurrent(abcg::Window::getSDLWindow(), m_GLContext);
+  invalidateGLStateCache();
+#if !defined(NDEBUG) && !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+  // Errors of contexts without the KHR_debug callback are checked with
+  // glGetError
+  glDebugState.enabled = m_debugOutput;
+#endif
+}
+
+void abcg::OpenGLWindow::handoff() { onHandoff(); }
+
+void abcg::OpenGLWindow::paint() {
+  auto const headless{abcg::Window::getWindowSettings().headless};
+  if (!headless && (m_hidden || m_minimized)) {
     return;
   }
 
-  SDL_GL_MakeCurrent(abcg::Window::getSDLWindow(), m_GLContext);
+  makeContextCurrent();
 
 #if defined(__EMSCRIPTEN__)
   // Force window size in windowed mode
@@ -445,27 +641,65 @@ void abcg::OpenGLWindow::paint() {
   }
 #endif
 
-  ImGui_ImplOpenGL3_NewFrame();
-  ImGui_ImplSDL2_NewFrame();
-  ImGui::NewFrame();
+  m_GPUTimer.beginFrame();
+
+  {
+    ABCG_PROFILE_SCOPE("onPaintUI");
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplSDL2_NewFrame();
+    ImGui::NewFrame();
+
+    onPaintUI();
+
+    ImGui::Render();
+  }
+
+  {
+    ABCG_PROFILE_SCOPE("onPaint");
+    onPaint();
+  }
 
-  onPaintUI();
+  {
+    ABCG_PROFILE_SCOPE("Dear ImGui rendering");
+    m_GPUTimer.beginPass("Dear ImGui");
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    // Dear ImGui binds objects through OpenGL functions of the global
+    // namespace
+    invalidateGLStateCache();
+    m_GPUTimer.endPass();
+  }
 
-  ImGui::Render();
+  m_GPUTimer.endFrame();
 
-  onPaint();
+#if defined(NDEBUG) && defined(ABCG_GL_SAMPLED_ERROR_CHECKS) &&                \
+    !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+  // Check the calls not checked yet, at least once per frame
+  checkSampledGLErrors();
+#endif
 
-  ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-  if (m_openGLSettings.doubleBuffering) {
+  ABCG_PROFILE_SCOPE("Swap buffers");
+  if (m_openGLSettings.doubleBuffering && !headless) {
     SDL_GL_SwapWindow(abcg::Window::getSDLWindow());
   } else {
     glFinish();
   }
+
+#if defined(ABCG_GL_CALL_COUNTERS)
+  m_GLCallStatistics = OpenGLCallCounter::takeSnapshot();
+#endif
 }
 
 void abcg::OpenGLWindow::destroy() {
+  if (m_GLContext != nullptr) {
+    makeContextCurrent();
+  }
+
   onDestroy();
 
+  if (m_GLContext != nullptr) {
+    m_GPUTimer.destroy();
+  }
+
   if (ImGui::GetCurrentContext() != nullptr) {
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
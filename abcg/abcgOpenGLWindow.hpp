@@ -13,10 +13,13 @@
 #ifndef ABCG_OPENGL_WINDOW_HPP_
 #define ABCG_OPENGL_WINDOW_HPP_
 
+#include <span>
 #include <string>
+#include <string_view>
 
 #include "abcgExternal.hpp"
 #include "abcgOpenGLFunction.hpp"
+#include "abcgOpenGLGPUTimer.hpp"
 #include "abcgWindow.hpp"
 
 namespace abcg {
@@ -77,6 +80,33 @@ struct abcg::OpenGLSettings {
   bool vSync{false};
   /** @brief Whether the output is double buffered. */
   bool doubleBuffering{true};
+  /** @brief Whether to measure the GPU time of each frame with timer queries.
+   *
+   * @sa abcg::OpenGLWindow::getGPUFrameTime.
+   */
+  bool gpuTimerQueries{true};
+  /** @brief Whether to report OpenGL errors through the `KHR_debug` message
+   * callback instead of calling `glGetError` before and after each OpenGL
+   * function wrapper.
+   *
+   * This is only used in debug builds. A debug context is requested, and
+   * `glGetError` is still used if `KHR_debug` is not supported.
+   *
+   * @sa abcg::enableGLDebugOutput.
+   */
+  bool debugOutput{false};
+  /** @brief Directory of the on-disk cache of program binaries used by
+   * abcg::createOpenGLProgram, or an empty string to leave the cache as is
+   * (disabled by default).
+   *
+   * The cache directory is shared by all windows of the application. If more
+   * than one window sets it, the window created last takes precedence.
+   * Relative paths are relative to the current working directory. The cache
+   * is not available in WebGL.
+   *
+   * @sa abcg::setOpenGLProgramCacheDirectory.
+   */
+  std::string programCacheDirectory;
 };
 
 /**
@@ -92,37 +122,59 @@ struct abcg::OpenGLSettings {
  * @sa abcg::OpenGLWindow::onPaintUI for UI rendering.
  * @sa abcg::OpenGLWindow::onResize for handling of window resize events.
  * @sa abcg::OpenGLWindow::onUpdate for commands to be called every frame.
+ * @sa abcg::OpenGLWindow::onFixedUpdate for fixed-timestep updates.
+ * @sa abcg::OpenGLWindow::onHandoff for handing off the updated state.
  * @sa abcg::OpenGLWindow::onDestroy for cleaning up OpenGL resources.
 
- * @remark Objects of this type cannot be copied or copy-constructed.
+ * @remark Objects of this type cannot be copied or moved.
  */
 class abcg::OpenGLWindow : public Window {
 public:
   [[nodiscard]] OpenGLSettings const &getOpenGLSettings() const noexcept;
   void setOpenGLSettings(OpenGLSettings const &openGLSettings) noexcept;
   void saveScreenshotPNG(std::string const &filename) const;
+  [[nodiscard]] double getGPUFrameTime() const noexcept final;
+  [[nodiscard]] std::span<GPUPassTime const>
+  getGPUPassTimes() const noexcept final;
+  [[nodiscard]] OpenGLCallStatistics const &
+  getGLCallStatistics() const noexcept;
 
 protected:
+  void beginGPUPass(std::string_view name);
+  void endGPUPass();
+
   virtual void onEvent(SDL_Event const &event);
   virtual void onCreate();
   virtual void onPaint();
   virtual void onPaintUI();
   virtual void onResize(glm::ivec2 const &size);
   virtual void onUpdate();
+  virtual void onFixedUpdate(double deltaTime);
+  virtual void onHandoff();
   virtual void onDestroy();
 
 private:
   void handleEvent(SDL_Event const &event) final;
   void create() final;
   void paint() final;
+  void fixedUpdate(double deltaTime) final;
+  void update() final;
+  void handoff() final;
   void destroy() final;
   [[nodiscard]] glm::ivec2 getWindowSize() const final;
+  void makeContextCurrent();
 
   OpenGLSettings m_openGLSettings;
   std::string m_GLSLVersion;
   SDL_GLContext m_GLContext{};
+  OpenGLGPUTimer m_GPUTimer;
+  OpenGLCallStatistics m_GLCallStatistics;
   bool m_hidden{};
   bool m_minimized{};
+#if !defined(NDEBUG) && !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+  // Whether errors of this context are reported by the KHR_debug callback
+  bool m_debugOutput{};
+#endif
 };
 
 #endif
@@ -0,0 +1,261 @@
+/**
+ * @file abcgProfiler.cpp
+ * @brief Definition of abcg::Profiler members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgProfiler.hpp"
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "abcgException.hpp"
+
+namespace {
+struct Zone {
+  char const *name{};
+  std::int64_t start{};
+  std::int64_t end{};
+};
+
+using Zones = std::array<Zone, abcg::Profiler::bufferSize>;
+
+// Zones and name of a single thread
+struct ThreadBuffer {
+  // Ring buffer of zones, allocated when the first zone is recorded. Set with
+  // the registry mutex locked
+  std::unique_ptr<Zones> zones;
+  std::atomic<std::size_t> count{};
+  std::size_t threadID{};
+  // Whether the thread has exited, so that clear() can release the buffer
+  std::atomic<bool> exited{};
+  std::mutex nameMutex;
+  std::string name;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::size_t nextThreadID{1};
+};
+
+Registry &getRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+// Thread-local owner of the buffer of a thread, which marks it as exited when
+// the thread exits
+struct ThreadBufferOwner {
+  ThreadBufferOwner() = default;
+  ThreadBufferOwner(ThreadBufferOwner const &) = delete;
+  ThreadBufferOwner(ThreadBufferOwner &&) = delete;
+  ThreadBufferOwner &operator=(ThreadBufferOwner const &) = delete;
+  ThreadBufferOwner &operator=(ThreadBufferOwner &&) = delete;
+  ~ThreadBufferOwner() {
+    if (buffer) {
+      buffer->exited.store(true, std::memory_order_release);
+    }
+  }
+
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+std::chrono::steady_clock::time_point getEpoch() {
+  static auto const epoch{std::chrono::steady_clock::now()};
+  return epoch;
+}
+
+// Returns the buffer of the calling thread, registering it on first use. The
+// registry keeps the buffer alive after the thread exits, until clear() is
+// called
+ThreadBuffer &getThreadBuffer() {
+  thread_local ThreadBufferOwner owner;
+  if (!owner.buffer) {
+    auto newBuffer{std::make_shared<ThreadBuffer>()};
+    auto &registry{getRegistry()};
+    std::scoped_lock const lock{registry.mutex};
+    newBuffer->threadID = registry.nextThreadID++;
+    registry.buffers.push_back(newBuffer);
+    owner.buffer = std::move(newBuffer);
+  }
+  return *owner.buffer;
+}
+
+std::string escapeJSON(std::string_view text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (auto const character : text) {
+    if (character == '"' || character == '\\') {
+      escaped += '\\';
+    }
+    escaped += character;
+  }
+  return escaped;
+}
+} // namespace
+
+/**
+ * @brief Enables or disables the recording of zones.
+ *
+ * @param enabled Whether to record zones.
+ */
+void abcg::Profiler::setEnabled(bool enabled) noexcept {
+  m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns whether the recording of zones is enabled.
+ *
+ * @return `true` if zones are being recorded, `false` otherwise.
+ */
+bool abcg::Profiler::isEnabled() noexcept {
+  return m_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the name of the calling thread in the exported trace.
+ *
+ * Only the name is stored. The buffer of zones of the thread is allocated when
+ * the thread records its first zone.
+ *
+ * @param name Name of the thread.
+ */
+void abcg::Profiler::setThreadName(std::string_view name) {
+  auto &buffer{getThreadBuffer()};
+  std::scoped_lock const lock{buffer.nameMutex};
+  buffer.name = name;
+}
+
+/**
+ * @brief Discards all recorded zones.
+ *
+ * The buffers of threads that have exited are released.
+ *
+ * @remark Zones being recorded concurrently by other threads may be lost.
+ */
+void abcg::Profiler::clear() {
+  auto &registry{getRegistry()};
+  std::scoped_lock const lock{registry.mutex};
+  std::erase_if(registry.buffers, [](auto const &buffer) {
+    return buffer->exited.load(std::memory_order_acquire);
+  });
+  for (auto const &buffer : registry.buffers) {
+    buffer->count.store(0, std::memory_order_release);
+  }
+}
+
+/**
+ * @brief Writes the recorded zones to a file in the Chrome trace event format.
+ *
+ * @param filename Path of the JSON file to be created.
+ *
+ * @throw abcg::RuntimeError if the file cannot be created.
+ *
+ * @remark Zones being recorded concurrently by other threads while the file is
+ * written may be inconsistent. Call this function when the other threads are
+ * idle, e.g., from the main thread between frames.
+ */
+void abcg::Profiler::writeChromeTrace(std::string const &filename) {
+  std::ofstream stream(filename);
+  if (!stream) {
+    throw abcg::RuntimeError(
+        fmt::format("Failed to create trace file {}", filename));
+  }
+
+  auto &registry{getRegistry()};
+  std::scoped_lock const lock{registry.mutex};
+
+  stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  auto first{true};
+  auto const separator{[&stream, &first] {
+    if (!first) {
+      stream << ",\n";
+    }
+    first = false;
+  }};
+
+  for (auto const &buffer : registry.buffers) {
+    {
+      std::scoped_lock const nameLock{buffer->nameMutex};
+      if (!buffer->name.empty()) {
+        separator();
+        stream << fmt::format(
+            R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},)"
+            R"("args":{{"name":"{}"}}}})",
+            buffer->threadID, escapeJSON(buffer->name));
+      }
+    }
+
+    if (!buffer->zones) {
+      continue;
+    }
+    auto const count{buffer->count.load(std::memory_order_acquire)};
+    auto const numZones{std::min(count, bufferSize)};
+    for (auto index{count - numZones}; index < count; ++index) {
+      auto const &zone{buffer->zones->at(index % bufferSize)};
+      separator();
+      // Timestamps are in microseconds
+      stream << fmt::format(
+          R"({{"name":"{}","ph":"X","pid":1,"tid":{},)"
+          R"("ts":{:.3f},"dur":{:.3f}}})",
+          escapeJSON(zone.name), buffer->threadID,
+          static_cast<double>(zone.start) / 1000.0,
+          static_cast<double>(zone.end - zone.start) / 1000.0);
+    }
+  }
+  stream << "]}\n";
+}
+
+/**
+ * @brief Records a zone in the buffer of the calling thread.
+ *
+ * @param name Name of the zone. Must be a string with static storage duration.
+ * @param start Start time, in nanoseconds, as returned by abcg::Profiler::now.
+ * @param end End time, in nanoseconds, as returned by abcg::Profiler::now.
+ *
+ * @remark This is called by the destructor of abcg::ProfileScope, so it does
+ * not throw. If the buffer of the calling thread cannot be allocated, the zone
+ * is dropped.
+ */
+void abcg::Profiler::recordZone(char const *name, std::int64_t start,
+                                std::int64_t end) noexcept {
+  ThreadBuffer *buffer{};
+  try {
+    buffer = &getThreadBuffer();
+    if (!buffer->zones) {
+      auto zones{std::make_unique<Zones>()};
+      auto &registry{getRegistry()};
+      std::scoped_lock const lock{registry.mutex};
+      buffer->zones = std::move(zones);
+    }
+  } catch (...) {
+    // The allocation is attempted again by the next zone of this thread
+    return;
+  }
+  auto const count{buffer->count.load(std::memory_order_relaxed)};
+  (*buffer->zones)[count % bufferSize] = {.name = name, .start = start,
+                                          .end = end};
+  buffer->count.store(count + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the current time of the profiler clock.
+ *
+ * @return Time, in nanoseconds, since the profiler was initialized.
+ */
+std::int64_t abcg::Profiler::now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - getEpoch())
+      .count();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file abcgProfiler.hpp
+ * @brief Header file of abcg::Profiler and abcg::ProfileScope.
+ *
+ * Declaration of abcg::Profiler, abcg::ProfileScope and the
+ * ABCG_PROFILE_SCOPE macro.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_PROFILER_HPP_
+#define ABCG_PROFILER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace abcg {
+class Profiler;
+class ProfileScope;
+} // namespace abcg
+
+/**
+ * @brief Records the duration of code regions (zones) of the application.
+ *
+ * Zones are usually recorded with the ABCG_PROFILE_SCOPE macro. Each thread
+ * writes its zones to its own ring buffer, without locking, so profiling can
+ * be used in worker threads with a low overhead. When the buffer of a thread
+ * is full, the oldest zones of the thread are overwritten.
+ *
+ * The recorded zones can be exported to a JSON file in the Chrome trace event
+ * format with abcg::Profiler::writeChromeTrace. Open the file in
+ * `chrome://tracing` or in the Perfetto UI (https://ui.perfetto.dev).
+ *
+ * Profiling is disabled by default. When disabled, a zone costs a single
+ * atomic load.
+ */
+class abcg::Profiler {
+public:
+  /** @brief Maximum number of zones stored for each thread. */
+  static constexpr std::size_t bufferSize{16384};
+
+  static void setEnabled(bool enabled) noexcept;
+  [[nodiscard]] static bool isEnabled() noexcept;
+
+  static void setThreadName(std::string_view name);
+  static void clear();
+  static void writeChromeTrace(std::string const &filename);
+
+  static void recordZone(char const *name, std::int64_t start,
+                         std::int64_t end) noexcept;
+  [[nodiscard]] static std::int64_t now() noexcept;
+
+private:
+  static inline std::atomic<bool> m_enabled{};
+};
+
+/**
+ * @brief Records a profiler zone that starts when this object is constructed
+ * and ends when it is destroyed.
+ *
+ * @sa ABCG_PROFILE_SCOPE
+ */
+class abcg::ProfileScope {
+public:
+  /**
+   * @brief Starts a zone.
+   *
+   * @param name Name of the zone. Must be a string with static storage
+   * duration, such as a string literal.
+   */
+  explicit ProfileScope(char const *name) noexcept
+      : m_name{Profiler::isEnabled() ? name : nullptr},
+        m_start{m_name != nullptr ? Profiler::now() : 0} {}
+  ProfileScope(ProfileScope const &) = delete;
+  ProfileScope(ProfileScope &&) = delete;
+  ProfileScope &operator=(ProfileScope const &) = delete;
+  ProfileScope &operator=(ProfileScope &&) = delete;
+  /**
+   * @brief Ends the zone.
+   */
+  ~ProfileScope() {
+    if (m_name != nullptr) {
+      Profiler::recordZone(m_name, m_start, Profiler::now());
+    }
+  }
+
+private:
+  char const *m_name;
+  std::int64_t m_start;
+};
+
+// @cond Skipped by Doxygen
+#define ABCG_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ABCG_PROFILE_CONCAT(a, b) ABCG_PROFILE_CONCAT_IMPL(a, b)
+// @endcond
+
+#if defined(ABCG_DISABLE_PROFILER)
+#define ABCG_PROFILE_SCOPE(name)
+#else
+/**
+ * @brief Records a profiler zone from this point until the end of the
+ * enclosing scope.
+ *
+ * @param name Name of the zone. Must be a string literal.
+ *
+ * @remark Define `ABCG_DISABLE_PROFILER` to compile out all zones.
+ */
+#define ABCG_PROFILE_SCOPE(name)                                               \
+  abcg::ProfileScope const ABCG_PROFILE_CONCAT(abcgProfileScope,               \
+                                               __LINE__) {                     \
+    name                                                                       \
+  }
+#endif
+
+#endif
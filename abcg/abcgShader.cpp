@@ -0,0 +1,47 @@
+/**
+ * @file abcgShader.cpp
+ * @brief Definition of helper functions shared by the OpenGL and Vulkan
+ * shaders.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgShader.hpp"
+
+#include <fmt/core.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "abcgException.hpp"
+
+/**
+ * @brief Returns the source code of a shader given either its path or its
+ * source code.
+ *
+ * @param pathOrSource Path to a shader file (assumed to be in text format), or
+ * the shader source code.
+ *
+ * @return Contents of the file if @a pathOrSource is the path of an existing
+ * file. Otherwise, @a pathOrSource itself.
+ *
+ * @throw abcg::RuntimeError if the file exists but cannot be read.
+ */
+std::string abcg::readShaderSource(std::string_view pathOrSource) {
+  static const std::size_t maxPathSize{260};
+  std::string str{pathOrSource};
+  if (str.size() > maxPathSize || !std::filesystem::exists(str)) {
+    return str;
+  }
+  std::ifstream stream(str);
+  if (!stream) {
+    throw abcg::RuntimeError(fmt::format("Failed to read file {}", str));
+  }
+  std::stringstream source;
+  source << stream.rdbuf();
+  return source.str();
+}
@@ -13,10 +13,12 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace abcg {
 struct ShaderSource;
 enum class ShaderStage : std::uint8_t;
+std::string readShaderSource(std::string_view pathOrSource);
 } // namespace abcg
 
 /**
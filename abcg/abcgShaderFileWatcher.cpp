@@ -0,0 +1,156 @@
+/**
+ * @file abcgShaderFileWatcher.cpp
+ * @brief Definition of abcg::ShaderFileWatcher members.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgShaderFileWatcher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define ABCG_USE_INOTIFY
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// Resolves the directory but not the file name, which is how inotify reports
+// the changed files
+std::filesystem::path toAbsolutePath(std::string_view path) {
+  std::error_code errorCode;
+  auto const absolutePath{std::filesystem::absolute(path, errorCode)};
+  auto directory{
+      std::filesystem::weakly_canonical(absolutePath.parent_path(), errorCode)};
+  if (errorCode) {
+    directory = absolutePath.parent_path();
+  }
+  return (directory / absolutePath.filename()).lexically_normal();
+}
+
+std::filesystem::file_time_type getLastWriteTime(
+    std::filesystem::path const &path) {
+  std::error_code errorCode;
+  auto const time{std::filesystem::last_write_time(path, errorCode)};
+  return errorCode ? std::filesystem::file_time_type{} : time;
+}
+} // namespace
+
+/**
+ * @brief Stops watching all files.
+ */
+abcg::ShaderFileWatcher::~ShaderFileWatcher() {
+#if defined(ABCG_USE_INOTIFY)
+  if (m_inotify >= 0) {
+    close(m_inotify);
+  }
+#endif
+}
+
+/**
+ * @brief Starts watching a file.
+ *
+ * @param path Path of the file.
+ *
+ * @return `true` if @a path is an existing file and is now watched; `false`
+ * otherwise, e.g., if @a path is a shader source code instead of a path.
+ */
+bool abcg::ShaderFileWatcher::watch(std::string_view path) {
+  // Same limit used by abcg::readShaderSource to tell paths from sources
+  static constexpr std::size_t maxPathSize{260};
+  std::error_code errorCode;
+  if (path.empty() || path.size() > maxPathSize ||
+      !std::filesystem::is_regular_file(path, errorCode)) {
+    return false;
+  }
+
+  auto const absolutePath{toAbsolutePath(path)};
+  if (m_files.contains(absolutePath)) {
+    return true;
+  }
+  File file{.path = std::string{path},
+            .lastWriteTime = getLastWriteTime(absolutePath)};
+
+#if defined(ABCG_USE_INOTIFY)
+  if (m_inotify < 0) {
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  }
+  if (m_inotify >= 0) {
+    auto const directory{absolutePath.parent_path()};
+    // Watching a directory twice returns the same watch descriptor
+    auto const descriptor{inotify_add_watch(m_inotify, directory.c_str(),
+                                            IN_CLOSE_WRITE | IN_MOVED_TO)};
+    if (descriptor >= 0) {
+      m_directories[descriptor] = directory;
+      file.notified = true;
+    }
+  }
+#endif
+
+  m_files.emplace(absolutePath, std::move(file));
+  return true;
+}
+
+/**
+ * @brief Returns the files changed since the previous call.
+ *
+ * This function does not block.
+ *
+ * @return Paths of the changed files, as given to
+ * abcg::ShaderFileWatcher::watch. Each path appears at most once.
+ */
+std::vector<std::string> abcg::ShaderFileWatcher::poll() {
+  std::vector<std::string> changedPaths;
+  auto const addChanged{[&changedPaths](std::string const &path) {
+    if (std::ranges::find(changedPaths, path) == changedPaths.end()) {
+      changedPaths.push_back(path);
+    }
+  }};
+
+#if defined(ABCG_USE_INOTIFY)
+  if (m_inotify >= 0) {
+    alignas(inotify_event) std::array<char, 4096> buffer{};
+    while (true) {
+      auto const length{read(m_inotify, buffer.data(), buffer.size())};
+      if (length <= 0) {
+        break;
+      }
+      auto const *const end{std::next(buffer.data(), length)};
+      for (auto const *event{buffer.data()}; event < end;) {
+        inotify_event header{};
+        std::memcpy(&header, event, sizeof(header));
+        auto const *const name{std::next(event, sizeof(header))};
+        if (auto const directory{m_directories.find(header.wd)};
+            header.len > 0 && directory != m_directories.end()) {
+          auto const file{m_files.find(directory->second / name)};
+          if (file != m_files.end()) {
+            addChanged(file->second.path);
+          }
+        }
+        event = std::next(name, header.len);
+      }
+    }
+  }
+#endif
+
+  // Compare the last write times of files not watched by inotify
+  for (auto &[absolutePath, file] : m_files) {
+    if (file.notified) {
+      continue;
+    }
+    if (auto const time{getLastWriteTime(absolutePath)};
+        time != file.lastWriteTime) {
+      file.lastWriteTime = time;
+      addChanged(file.path);
+    }
+  }
+
+  return changedPaths;
+}
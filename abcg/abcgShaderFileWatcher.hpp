@@ -0,0 +1,68 @@
+/**
+ * @file abcgShaderFileWatcher.hpp
+ * @brief Header file of abcg::ShaderFileWatcher.
+ *
+ * Declaration of abcg::ShaderFileWatcher.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_SHADER_FILE_WATCHER_HPP_
+#define ABCG_SHADER_FILE_WATCHER_HPP_
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace abcg {
+class ShaderFileWatcher;
+} // namespace abcg
+
+/**
+ * @brief Detects changes to shader files.
+ *
+ * On Linux, the directories of the watched files are monitored with inotify,
+ * and abcg::ShaderFileWatcher::poll only reads the pending events. Files are
+ * considered changed when they are closed after writing or moved into place,
+ * which also covers editors that save to a temporary file and rename it. On
+ * other platforms, or if inotify is not available,
+ * abcg::ShaderFileWatcher::poll compares the last write time of each file.
+ *
+ * @remark Objects of this type cannot be copied or copy-constructed.
+ *
+ * @sa abcg::OpenGLShaderHotReload.
+ */
+class abcg::ShaderFileWatcher {
+public:
+  ShaderFileWatcher() = default;
+  ShaderFileWatcher(ShaderFileWatcher const &) = delete;
+  ShaderFileWatcher(ShaderFileWatcher &&) = delete;
+  ShaderFileWatcher &operator=(ShaderFileWatcher const &) = delete;
+  ShaderFileWatcher &operator=(ShaderFileWatcher &&) = delete;
+  ~ShaderFileWatcher();
+
+  bool watch(std::string_view path);
+  [[nodiscard]] std::vector<std::string> poll();
+
+private:
+  struct File {
+    // Path as given to watch()
+    std::string path;
+    std::filesystem::file_time_type lastWriteTime;
+    // Whether the directory of the file is watched by inotify
+    bool notified{};
+  };
+
+  // Watched files by absolute path
+  std::map<std::filesystem::path, File> m_files;
+  // Directories watched by inotify, by watch descriptor
+  std::map<int, std::filesystem::path> m_directories;
+  int m_inotify{-1};
+};
+
+#endif
@@ -0,0 +1,256 @@
+/**
+ * @file abcgStd140.hpp
+ * @brief Header file of abcg::Std140Layout and related templates.
+ *
+ * Compile-time generation of the std140 layout of uniform blocks.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_STD140_HPP_
+#define ABCG_STD140_HPP_
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#include <glm/glm.hpp>
+#include <gsl/gsl>
+
+namespace abcg {
+template <typename T> struct Std140Members;
+template <typename T> struct Std140Layout;
+
+/**
+ * @brief Concept of the scalar types allowed in std140 uniform blocks.
+ *
+ * GLSL `bool` is not supported, as its size differs from C++ `bool`. Use
+ * `std::uint32_t` instead.
+ */
+template <typename T>
+concept Std140Scalar =
+    std::same_as<T, float> || std::same_as<T, std::int32_t> ||
+    std::same_as<T, std::uint32_t>;
+
+/**
+ * @brief Rounds a value up to a multiple of an alignment.
+ *
+ * @param value Value to be rounded up.
+ * @param alignment Alignment. Must be greater than zero.
+ *
+ * @return Smallest multiple of @a alignment not less than @a value.
+ */
+constexpr std::size_t std140AlignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/** @brief Size of a type in the std140 layout, in bytes. */
+template <typename T>
+inline constexpr std::size_t std140Size{Std140Layout<T>::size};
+
+/**
+ * @brief Offset of a member of a struct in the std140 layout, in bytes.
+ *
+ * @tparam T Struct described by an abcg::Std140Members specialization.
+ * @tparam Index Index of the member in abcg::Std140Members<T>::members.
+ */
+template <typename T, std::size_t Index>
+inline constexpr std::size_t std140Offset{
+    std::get<Index>(Std140Layout<T>::offsets)};
+
+/**
+ * @brief Writes a value in the std140 layout.
+ *
+ * Padding bytes are left unchanged.
+ *
+ * @tparam T Type of the value.
+ *
+ * @param value Value to be written.
+ * @param destination Memory where the value is written. Its size must be at
+ * least abcg::std140Size<T>.
+ */
+template <typename T>
+void writeStd140(T const &value, std::span<std::byte> destination) {
+  Expects(destination.size() >= std140Size<T>);
+  Std140Layout<T>::write(value, destination.data());
+}
+} // namespace abcg
+
+/**
+ * @brief Describes the members of a struct used as a std140 uniform block.
+ *
+ * Specialize this template for each struct that mirrors a GLSL uniform block.
+ * The specialization must have a static constexpr tuple named `members` with
+ * pointers to the data members, in the order they are declared in the block.
+ * For instance, the block
+ *
+ * @code{.glsl}
+ * layout(std140) uniform Material {
+ *   vec3 diffuse;
+ *   float shininess;
+ *   mat3 normalMatrix;
+ * };
+ * @endcode
+ *
+ * can be described as follows:
+ *
+ * @code
+ * struct Material {
+ *   glm::vec3 diffuse;
+ *   float shininess;
+ *   glm::mat3 normalMatrix;
+ * };
+ *
+ * template <> struct abcg::Std140Members<Material> {
+ *   static constexpr std::tuple members{
+ *       &Material::diffuse, &Material::shininess, &Material::normalMatrix};
+ * };
+ *
+ * static_assert(abcg::std140Offset<Material, 2> == 16);
+ * static_assert(abcg::std140Size<Material> == 64);
+ * @endcode
+ *
+ * The std140 layout is computed at compile time by abcg::Std140Layout and
+ * does not need to match the layout of the C++ struct. Members can be
+ * scalars (abcg::Std140Scalar), `glm` vectors and float matrices, `std::array`
+ * of these types, and other structs described by this template.
+ */
+template <typename T> struct abcg::Std140Members {};
+
+/**
+ * @brief std140 layout of a type, computed at compile time.
+ *
+ * This is the layout of structs described by abcg::Std140Members. It has
+ * the following members:
+ *
+ * - `alignment`: base alignment, in bytes;
+ * - `size`: size, in bytes, including the padding at the end;
+ * - `offsets` (structs only): offset of each member, in bytes;
+ * - `write(value, destination)`: writes a value in the layout.
+ *
+ * Types not supported by std140 fail to compile with a static assertion.
+ */
+template <typename T> struct abcg::Std140Layout {
+  static_assert(requires { Std140Members<T>::members; },
+                "Type is not supported by the std140 layout. Specialize "
+                "abcg::Std140Members to describe the members of a struct");
+
+private:
+  static constexpr auto &members{Std140Members<T>::members};
+  static constexpr auto numMembers{
+      std::tuple_size_v<std::remove_cvref_t<decltype(members)>>};
+
+  template <typename TMemberPointer> struct MemberOf;
+  template <typename TClass, typename TMember>
+  struct MemberOf<TMember TClass::*> {
+    static_assert(std::same_as<TClass, T>,
+                  "abcg::Std140Members<T>::members must point to members of T");
+    using Layout = Std140Layout<TMember>;
+  };
+
+  template <std::size_t Index>
+  using MemberLayout = typename MemberOf<
+      std::tuple_element_t<Index, std::remove_cvref_t<decltype(members)>>>::
+      Layout;
+
+  // Offsets of the members followed by the end of the last member
+  static constexpr auto layout{[]<std::size_t... Index>(
+                                   std::index_sequence<Index...>) {
+    std::array<std::size_t, sizeof...(Index) + 1> result{};
+    std::size_t end{};
+    ((result.at(Index) =
+          std140AlignUp(end, MemberLayout<Index>::alignment),
+      end = result.at(Index) + MemberLayout<Index>::size),
+     ...);
+    result.back() = end;
+    return result;
+  }(std::make_index_sequence<numMembers>{})};
+
+public:
+  static constexpr std::size_t alignment{
+      []<std::size_t... Index>(std::index_sequence<Index...>) {
+        return std140AlignUp(
+            std::max({std::size_t{16}, MemberLayout<Index>::alignment...}), 16);
+      }(std::make_index_sequence<numMembers>{})};
+  static constexpr std::size_t size{std140AlignUp(layout.back(), alignment)};
+  static constexpr auto offsets{[] {
+    std::array<std::size_t, numMembers> result{};
+    std::copy_n(layout.begin(), numMembers, result.begin());
+    return result;
+  }()};
+
+  static void write(T const &value, std::byte *destination) {
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+      (MemberLayout<Index>::write(value.*std::get<Index>(members),
+                                  destination + offsets.at(Index)),
+       ...);
+    }(std::make_index_sequence<numMembers>{});
+  }
+};
+
+/** @brief std140 layout of scalars. */
+template <abcg::Std140Scalar T> struct abcg::Std140Layout<T> {
+  static constexpr std::size_t alignment{sizeof(T)};
+  static constexpr std::size_t size{sizeof(T)};
+
+  static void write(T const &value, std::byte *destination) {
+    std::memcpy(destination, &value, sizeof(T));
+  }
+};
+
+/** @brief std140 layout of vectors. Three-component vectors are aligned as
+ * four-component vectors. */
+template <glm::length_t L, abcg::Std140Scalar T, glm::qualifier Q>
+struct abcg::Std140Layout<glm::vec<L, T, Q>> {
+  static constexpr std::size_t alignment{(L == 2 ? 2 : 4) * sizeof(T)};
+  static constexpr std::size_t size{L * sizeof(T)};
+
+  static void write(glm::vec<L, T, Q> const &value, std::byte *destination) {
+    std::memcpy(destination, &value[0], size);
+  }
+};
+
+/** @brief std140 layout of column-major float matrices. Each column is aligned
+ * as a `vec4`. */
+template <glm::length_t C, glm::length_t R, glm::qualifier Q>
+struct abcg::Std140Layout<glm::mat<C, R, float, Q>> {
+  static constexpr std::size_t alignment{16};
+  static constexpr std::size_t size{C * alignment};
+
+  static void write(glm::mat<C, R, float, Q> const &value,
+                    std::byte *destination) {
+    for (std::size_t column{}; column < C; ++column) {
+      std::memcpy(destination + column * alignment,
+                  &value[gsl::narrow_cast<glm::length_t>(column)][0],
+                  R * sizeof(float));
+    }
+  }
+};
+
+/** @brief std140 layout of arrays. The stride of the elements is rounded up to
+ * a multiple of 16 bytes. */
+template <typename T, std::size_t N>
+struct abcg::Std140Layout<std::array<T, N>> {
+  static constexpr std::size_t alignment{
+      std140AlignUp(Std140Layout<T>::alignment, 16)};
+  static constexpr std::size_t stride{
+      std140AlignUp(Std140Layout<T>::size, alignment)};
+  static constexpr std::size_t size{N * stride};
+
+  static void write(std::array<T, N> const &value, std::byte *destination) {
+    for (std::size_t index{}; index < N; ++index) {
+      Std140Layout<T>::write(value[index], destination + index * stride);
+    }
+  }
+};
+
+#endif
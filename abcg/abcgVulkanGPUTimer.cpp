@@ -0,0 +1,196 @@
+/**
+ * @file abcgVulkanGPUTimer.cpp
+ * @brief Definition of abcg::VulkanGPUTimer
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#include "abcgVulkanGPUTimer.hpp"
+
+#include <cppitertools/itertools.hpp>
+#include <gsl/gsl>
+
+#include <array>
+
+#include "abcgVulkanDevice.hpp"
+#include "abcgVulkanPhysicalDevice.hpp"
+
+/**
+ * @brief Creates one timestamp query pool for each frame in flight.
+ *
+ * If the graphics queue family does not support timestamps, no query pool is
+ * created.
+ *
+ * @param device Vulkan device.
+ * @param numFrames Number of frames in flight.
+ */
+void abcg::VulkanGPUTimer::create(VulkanDevice const &device,
+                                  std::size_t numFrames) {
+  destroy();
+
+  auto const &physicalDevice{
+      static_cast<vk::PhysicalDevice>(device.getPhysicalDevice())};
+  auto const &queuesFamilies{device.getPhysicalDevice().getQueuesFamilies()};
+  if (!queuesFamilies.graphics.has_value()) {
+    return;
+  }
+
+  auto const timestampValidBits{
+      physicalDevice.getQueueFamilyProperties()
+          .at(queuesFamilies.graphics.value())
+          .timestampValidBits};
+  if (timestampValidBits == 0) {
+    return;
+  }
+  m_timestampMask = timestampValidBits >= 64
+                        ? ~uint64_t{}
+                        : (uint64_t{1} << timestampValidBits) - 1;
+  m_timestampPeriod = static_cast<double>(
+      physicalDevice.getProperties().limits.timestampPeriod);
+
+  m_device = static_cast<vk::Device>(device);
+  m_frames.resize(numFrames);
+  for (auto &frame : m_frames) {
+    frame.queryPool =
+        m_device.createQueryPool({.queryType = vk::QueryType::eTimestamp,
+                                  .queryCount = maxTimestamps});
+    frame.names.resize(maxTimestamps);
+  }
+}
+
+/**
+ * @brief Destroys the query pools.
+ *
+ * The pools must not be in use by the device.
+ */
+void abcg::VulkanGPUTimer::destroy() {
+  for (auto const &frame : m_frames) {
+    m_device.destroyQueryPool(frame.queryPool);
+  }
+  m_frames.clear();
+  m_currentFrame = nullptr;
+  m_device = vk::Device{};
+  m_frameTime = 0.0;
+  m_passTimes.clear();
+}
+
+/**
+ * @brief Returns whether timestamps are supported by the graphics queue.
+ *
+ * @return `true` if the GPU time can be measured, `false` otherwise.
+ */
+bool abcg::VulkanGPUTimer::isSupported() const noexcept {
+  return !m_frames.empty();
+}
+
+/**
+ * @brief Starts measuring a frame.
+ *
+ * Reads the results of the previous use of the frame, resets its query pool
+ * and writes the timestamp that marks the beginning of the frame, at the
+ * color attachment output stage, after the wait for the swapchain image.
+ *
+ * @param frameIndex Index of the frame in flight. Its fence must have
+ * signaled.
+ * @param commandBuffer Command buffer in the recording state, outside a render
+ * pass, submitted before any other command buffer of the frame.
+ */
+void abcg::VulkanGPUTimer::beginFrame(std::size_t frameIndex,
+                                      vk::CommandBuffer const &commandBuffer) {
+  if (m_frames.empty()) {
+    return;
+  }
+
+  m_currentFrame = &m_frames.at(frameIndex);
+  collect(*m_currentFrame);
+
+  m_currentFrame->numTimestamps = 0;
+  commandBuffer.resetQueryPool(m_currentFrame->queryPool, 0, maxTimestamps);
+  // The frame waits for the swapchain image at the color attachment output
+  // stage. A timestamp written at the top of the pipe would not wait for it,
+  // so the frame time would include the acquire and vsync wait
+  writeTimestamp(commandBuffer, {},
+                 vk::PipelineStageFlagBits::eColorAttachmentOutput);
+}
+
+/**
+ * @brief Writes a named timestamp that marks the end of a pass.
+ *
+ * The time of the pass is the time elapsed since the previous timestamp of the
+ * frame. Timestamps beyond abcg::VulkanGPUTimer::maxTimestamps are ignored.
+ *
+ * @param commandBuffer Command buffer of the current frame, in the recording
+ * state.
+ * @param name Name of the pass.
+ * @param stage Pipeline stage at which the timestamp is written.
+ */
+void abcg::VulkanGPUTimer::writeTimestamp(
+    vk::CommandBuffer const &commandBuffer, std::string_view name,
+    vk::PipelineStageFlagBits stage) {
+  if (m_currentFrame == nullptr ||
+      m_currentFrame->numTimestamps == maxTimestamps) {
+    return;
+  }
+
+  auto const query{m_currentFrame->numTimestamps++};
+  m_currentFrame->names.at(query) = name;
+  commandBuffer.writeTimestamp(stage, m_currentFrame->queryPool, query);
+}
+
+/**
+ * @brief Returns the GPU time of the most recent frame whose results are
+ * available.
+ *
+ * @return GPU time, in milliseconds, from the beginning of the frame to its
+ * last timestamp, or zero if no result is available.
+ */
+double abcg::VulkanGPUTimer::getFrameTime() const noexcept {
+  return m_frameTime;
+}
+
+/**
+ * @brief Returns the GPU time of the passes of the most recent frame whose
+ * results are available.
+ *
+ * @return Passes in the order their timestamps were written.
+ */
+std::span<abcg::GPUPassTime const>
+abcg::VulkanGPUTimer::getPassTimes() const noexcept {
+  return m_passTimes;
+}
+
+void abcg::VulkanGPUTimer::collect(Frame &frame) {
+  auto const numTimestamps{frame.numTimestamps};
+  if (numTimestamps < 2) {
+    return;
+  }
+
+  // Without eWait, this returns eNotReady instead of blocking if any result
+  // is not available yet
+  std::array<uint64_t, maxTimestamps> timestamps{};
+  if (m_device.getQueryPoolResults(
+          frame.queryPool, 0, numTimestamps,
+          numTimestamps * sizeof(uint64_t), timestamps.data(),
+          sizeof(uint64_t), vk::QueryResultFlagBits::e64) !=
+      vk::Result::eSuccess) {
+    return;
+  }
+
+  auto const toMilliseconds{[this](uint64_t begin, uint64_t end) {
+    auto const ticks{(end - begin) & m_timestampMask};
+    return static_cast<double>(ticks) * m_timestampPeriod / 1.0e6;
+  }};
+
+  m_passTimes.clear();
+  for (auto const query : iter::range(1U, numTimestamps)) {
+    m_passTimes.push_back(
+        {.name = frame.names.at(query),
+         .milliseconds = toMilliseconds(timestamps.at(query - 1),
+                                        timestamps.at(query))});
+  }
+  m_frameTime =
+      toMilliseconds(timestamps.front(), timestamps.at(numTimestamps - 1));
+}
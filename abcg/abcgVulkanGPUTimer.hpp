@@ -0,0 +1,81 @@
+/**
+ * @file abcgVulkanGPUTimer.hpp
+ * @brief Header file of abcg::VulkanGPUTimer.
+ *
+ * Declaration of abcg::VulkanGPUTimer.
+ *
+ * This file is part of ABCg (https://github.com/hbatagelo/abcg).
+ *
+ * @copyright (c) 2021--2026 Harlen Batagelo. All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef ABCG_VULKAN_GPU_TIMER_HPP_
+#define ABCG_VULKAN_GPU_TIMER_HPP_
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "abcgGPUTimer.hpp"
+#include "abcgVulkanExternal.hpp"
+
+namespace abcg {
+class VulkanDevice;
+class VulkanGPUTimer;
+} // namespace abcg
+
+/**
+ * @brief Measures the GPU time of frames and of named passes of a frame using
+ * Vulkan timestamp queries.
+ *
+ * Each frame in flight has its own timestamp query pool. The results of a
+ * frame are read when the frame is reused, i.e., after its fence has signaled,
+ * so reading them never blocks.
+ *
+ * A pass is measured by writing a named timestamp at its end. The time of the
+ * pass is the time elapsed since the previous timestamp of the frame, or since
+ * the beginning of the frame.
+ *
+ * @remark If the graphics queue does not support timestamps, all functions do
+ * nothing.
+ */
+class abcg::VulkanGPUTimer {
+public:
+  /** @brief Maximum number of timestamps written in a frame. */
+  static constexpr uint32_t maxTimestamps{64};
+
+  void create(VulkanDevice const &device, std::size_t numFrames);
+  void destroy();
+  [[nodiscard]] bool isSupported() const noexcept;
+
+  void beginFrame(std::size_t frameIndex,
+                  vk::CommandBuffer const &commandBuffer);
+  void writeTimestamp(vk::CommandBuffer const &commandBuffer,
+                      std::string_view name,
+                      vk::PipelineStageFlagBits stage =
+                          vk::PipelineStageFlagBits::eBottomOfPipe);
+
+  [[nodiscard]] double getFrameTime() const noexcept;
+  [[nodiscard]] std::span<GPUPassTime const> getPassTimes() const noexcept;
+
+private:
+  struct Frame {
+    vk::QueryPool queryPool;
+    std::vector<std::string> names;
+    uint32_t numTimestamps{};
+  };
+
+  void collect(Frame &frame);
+
+  vk::Device m_device;
+  double m_timestampPeriod{};
+  uint64_t m_timestampMask{};
+  std::vector<Frame> m_frames;
+  Frame *m_currentFrame{};
+  double m_frameTime{};
+  std::vector<GPUPassTime> m_passTimes;
+};
+
+#endif
@@ -18,9 +18,6 @@
 #include <fmt/core.h>
 #include <gsl/gsl>
 
-#include <filesystem>
-#include <fstream>
-
 namespace {
 TBuiltInResource InitResources() {
   TBuiltInResource Resources{
@@ -236,25 +233,6 @@ abcgStageToVulkanStage(abcg::ShaderStage stage) {
   }
 }
 
-// If filenameOrText is a filename, returns the contents of the file (assumed
-// to be in text format). Otherwise, returns the filename.
-[[nodiscard]] std::string toSource(std::string_view filenameOrText) {
-  static const std::size_t maxPathSize{260};
-  std::string str{filenameOrText};
-  if (str.size() > maxPathSize ||
-      !std::filesystem::exists(str)) {
-    return str;
-  }
-  std::ifstream stream(str);
-  if (!stream) {
-    throw abcg::RuntimeError(
-      fmt::format("Failed to read file {}", str));
-    }
-    std::stringstream source;
-    source << stream.rdbuf();
-  return source.str();
-}
-
 // Compiles the given GLSL shader source into Vulkan SPIR-V.
 std::vector<uint32_t> GLSLtoSPV(abcg::ShaderSource shaderSource) {
   // Prints out log info for compiling and linking
@@ -303,6 +281,29 @@ std::vector<uint32_t> GLSLtoSPV(abcg::ShaderSource shaderSource) {
 }
 } // namespace
 
+/**
+ * @brief Compiles a GLSL shader to SPIR-V.
+ *
+ * This does not require a Vulkan device.
+ *
+ * @param pathOrSource Path or source code of the GLSL shader to be compiled to
+ * SPIR-V.
+ *
+ * @return SPIR-V code of the shader.
+ *
+ * @throw abcg::RuntimeError if the shader could not be read from file or has
+ * failed to compile.
+ */
+std::vector<uint32_t>
+abcg::compileShaderToSPIRV(ShaderSource const &pathOrSource) {
+  ShaderSource const source{.source = readShaderSource(pathOrSource.source),
+                            .stage = pathOrSource.stage};
+
+  glslang::InitializeProcess();
+  auto const finalize{gsl::finally([] { glslang::FinalizeProcess(); })};
+  return GLSLtoSPV(source);
+}
+
 /**
  * @brief Compiles a GLSL shader to SPIR-V and creates its module.
  *
@@ -317,13 +318,8 @@ void abcg::VulkanShader::create(VulkanDevice const &device,
                                 ShaderSource const &pathOrSource) {
   m_device = static_cast<vk::Device>(device);
 
-  ShaderSource const source{.source = toSource(pathOrSource.source),
-                            .stage = pathOrSource.stage};
-
-  glslang::InitializeProcess();
-  std::vector<uint32_t> shader{GLSLtoSPV(source)};
-  m_stage = abcgStageToVulkanStage(source.stage);
-  glslang::FinalizeProcess();
+  std::vector<uint32_t> const shader{compileShaderToSPIRV(pathOrSource)};
+  m_stage = abcgStageToVulkanStage(pathOrSource.stage);
 
   m_module = m_device.createShaderModule(
       {.codeSize = shader.size() * sizeof(uint32_t), .pCode = shader.data()});
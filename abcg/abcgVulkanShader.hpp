@@ -11,11 +11,15 @@
 #ifndef ABCG_VULKAN_SHADER_HPP_
 #define ABCG_VULKAN_SHADER_HPP_
 
+#include <cstdint>
+#include <vector>
+
 #include "abcgShader.hpp"
 #include "abcgVulkanDevice.hpp"
 
 namespace abcg {
 class VulkanShader;
+std::vector<uint32_t> compileShaderToSPIRV(ShaderSource const &pathOrSource);
 } // namespace abcg
 
 /**
@@ -119,6 +119,7 @@ void abcg::VulkanSwapchain::destroy() {
     return;
   }
 
+  m_GPUTimer.destroy();
   destroyMSAAResources();
   destroyDepthResources();
   destroyFrames();
@@ -158,6 +159,7 @@ void abcg::VulkanSwapchain::render(
   device.resetCommandPool(frame.commandPool);
 
   // Record command buffers
+  recordQueries(frame);
   recordMain(frame);
   recordUI(frame);
 
@@ -165,10 +167,25 @@ void abcg::VulkanSwapchain::render(
   submit(frame);
 }
 
+void abcg::VulkanSwapchain::recordQueries(VulkanFrame const &frame) {
+  frame.commandBufferQueries.begin(
+      {.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+
+  // The frame fence has signaled, so reading the results of the previous use
+  // of this frame does not block
+  m_GPUTimer.beginFrame(m_frameIndex, frame.commandBufferQueries);
+
+  frame.commandBufferQueries.end();
+}
+
 void abcg::VulkanSwapchain::recordUI(VulkanFrame const &frame) {
   frame.commandBufferUI.begin(
       {.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
 
+  // Command buffers of a submission start in submission order, so this marks
+  // the end of the main pass
+  m_GPUTimer.writeTimestamp(frame.commandBufferUI, "Main pass");
+
   std::array<vk::ClearValue, 2> const clearValues{};
 
   frame.commandBufferUI.beginRenderPass(
@@ -184,6 +201,8 @@ void abcg::VulkanSwapchain::recordUI(VulkanFrame const &frame) {
 
   frame.commandBufferUI.endRenderPass();
 
+  m_GPUTimer.writeTimestamp(frame.commandBufferUI, "Dear ImGui");
+
   frame.commandBufferUI.end();
 }
 
@@ -191,7 +210,8 @@ void abcg::VulkanSwapchain::submit(VulkanFrame const &frame) {
   std::array waitSemaphores{frame.imageAvailable};
   std::array waitStages{vk::PipelineStageFlags{
       vk::PipelineStageFlagBits::eColorAttachmentOutput}};
-  std::array commandBuffers{frame.commandBuffer, frame.commandBufferUI};
+  std::array commandBuffers{frame.commandBufferQueries, frame.commandBuffer,
+                            frame.commandBufferUI};
   std::array signalSemaphores{frame.renderComplete};
 
   // Submit command buffer
@@ -377,6 +397,10 @@ bool abcg::VulkanSwapchain::checkRebuild(VulkanSettings const &settings,
 
   createFramebuffers(settings);
 
+  if (settings.gpuTimerQueries) {
+    m_GPUTimer.create(m_device, m_framesInFlight.size());
+  }
+
   m_swapChainRebuild = false;
 
   return true;
@@ -455,6 +479,25 @@ abcg::VulkanImage const &abcg::VulkanSwapchain::getDepthImage() const noexcept {
   return m_depthImage;
 }
 
+/**
+ * @brief Returns the GPU timer of the frames in flight.
+ *
+ * @return GPU timer that measures the main pass and the UI pass of each frame.
+ */
+abcg::VulkanGPUTimer const &
+abcg::VulkanSwapchain::getGPUTimer() const noexcept {
+  return m_GPUTimer;
+}
+
+/**
+ * @brief Returns the GPU timer of the frames in flight.
+ *
+ * @return GPU timer that measures the main pass and the UI pass of each frame.
+ */
+abcg::VulkanGPUTimer &abcg::VulkanSwapchain::getGPUTimer() noexcept {
+  return m_GPUTimer;
+}
+
 void abcg::VulkanSwapchain::createFrames() {
   auto const &device{static_cast<vk::Device>(m_device)};
   auto const swapchainImages{
@@ -805,6 +848,15 @@ void abcg::VulkanSwapchain::createFramebuffers(VulkanSettings const &settings) {
         {.flags = vk::CommandPoolCreateFlagBits::eTransient,
          .queueFamilyIndex = graphicsQueueFamily});
 
+    // Create a primary command buffer for resetting and writing the queries
+    // that must precede the other commands of the frame
+    frame.commandBufferQueries =
+        device
+            .allocateCommandBuffers({.commandPool = frame.commandPool,
+                                     .level = vk::CommandBufferLevel::ePrimary,
+                                     .commandBufferCount = 1})
+            .front();
+
     // Create a primary command buffer
     frame.commandBuffer =
         device
@@ -17,6 +17,7 @@
 #include <glm/fwd.hpp>
 
 #include "abcgVulkanDevice.hpp"
+#include "abcgVulkanGPUTimer.hpp"
 #include "abcgVulkanImage.hpp"
 
 namespace abcg {
@@ -33,6 +34,7 @@ class VulkanWindow;
  */
 struct abcg::VulkanFrame {
   vk::CommandPool commandPool;
+  vk::CommandBuffer commandBufferQueries;
   vk::CommandBuffer commandBuffer;
   vk::CommandBuffer commandBufferUI;
   vk::Fence fence;
@@ -66,6 +68,8 @@ public:
   [[nodiscard]] vk::RenderPass const &getUIRenderPass() const noexcept;
   [[nodiscard]] vk::Extent2D const &getExtent() const noexcept;
   [[nodiscard]] VulkanImage const &getDepthImage() const noexcept;
+  [[nodiscard]] VulkanGPUTimer const &getGPUTimer() const noexcept;
+  [[nodiscard]] VulkanGPUTimer &getGPUTimer() noexcept;
 
 private:
   void createFrames();
@@ -83,6 +87,7 @@ private:
 
   void createFramebuffers(VulkanSettings const &settings);
 
+  void recordQueries(VulkanFrame const &frame);
   void recordUI(VulkanFrame const &frame);
   void submit(VulkanFrame const &frame);
 
@@ -104,6 +109,8 @@ private:
   // Render passes
   vk::RenderPass m_renderPassMain;
   vk::RenderPass m_renderPassUI;
+
+  VulkanGPUTimer m_GPUTimer;
 };
 
 #endif
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 #include "abcgEmbeddedFonts.hpp"
 #include "abcgException.hpp"
+#include "abcgProfiler.hpp"
 #include "abcgVulkanError.hpp"
 #include "abcgVulkanInstance.hpp"
 #include "abcgWindow.hpp"
@@ -111,6 +112,55 @@ abcg::VulkanSwapchain const &abcg::VulkanWindow::getSwapchain() const noexcept {
   return m_swapchain;
 }
 
+/**
+ * @brief Returns the GPU time of a recent frame.
+ *
+ * The time is measured with timestamp queries whose results are read when the
+ * frame in flight is reused, so it refers to a frame painted a few frames
+ * ago.
+ *
+ * @return GPU time, in milliseconds, or zero if it is not available, e.g., if
+ * abcg::VulkanSettings::gpuTimerQueries is `false` or timestamps are not
+ * supported by the graphics queue.
+ *
+ * @sa abcg::VulkanGPUTimer::getFrameTime.
+ */
+double abcg::VulkanWindow::getGPUFrameTime() const noexcept {
+  return m_swapchain.getGPUTimer().getFrameTime();
+}
+
+/**
+ * @brief Returns the GPU time of the passes of a recent frame.
+ *
+ * The passes are those ended by abcg::VulkanWindow::writeGPUTimestamp, followed
+ * by "Main pass", which measures the remaining commands of
+ * `VulkanFrame::commandBuffer`, and "Dear ImGui", which measures the UI pass.
+ *
+ * @return GPU time of each pass of the frame whose time is returned by
+ * abcg::VulkanWindow::getGPUFrameTime.
+ */
+std::span<abcg::GPUPassTime const>
+abcg::VulkanWindow::getGPUPassTimes() const noexcept {
+  return m_swapchain.getGPUTimer().getPassTimes();
+}
+
+/**
+ * @brief Writes a named timestamp into the main command buffer of a frame.
+ *
+ * Call this in abcg::VulkanWindow::onPaint to mark the end of a pass. The time
+ * of the pass is measured from the previous timestamp of the frame, or from
+ * the beginning of the frame. The results are available a few frames later
+ * through abcg::VulkanWindow::getGPUPassTimes.
+ *
+ * @param frame Frame being recorded. Its `commandBuffer` must be in the
+ * recording state.
+ * @param name Name of the pass.
+ */
+void abcg::VulkanWindow::writeGPUTimestamp(VulkanFrame const &frame,
+                                           std::string_view name) {
+  m_swapchain.getGPUTimer().writeTimestamp(frame.commandBuffer, name);
+}
+
 /**
  * @brief Custom event handler.
  *
@@ -155,37 +205,15 @@ void abcg::VulkanWindow::onPaint([[maybe_unused]] VulkanFrame const &frame) {}
  *
  * This is not called when the window is minimized.
  *
- * Override it for custom behavior. By default, it shows a FPS counter if
+ * Override it for custom behavior. By default, it shows a FPS counter with
+ * frame time statistics (see abcg::Window::paintFrameStatisticsUI) if
  * abcg::WindowSettings::showFPS is set to `true`, and a toggle fullscreen
  * button if abcg::WindowSettings::showFullscreenButton is set to `true`.
  */
 void abcg::VulkanWindow::onPaintUI() {
   // FPS counter
   if (abcg::Window::getWindowSettings().showFPS) {
-    auto fps{ImGui::GetIO().Framerate};
-
-    static auto offset{0UL};
-    static auto refreshTime{ImGui::GetTime()};
-    static std::array<float, 150> frames{};
-
-    while (refreshTime < ImGui::GetTime()) {
-      auto const refreshFrequency{60.0};
-      frames.at(offset) = fps;
-      offset = (offset + 1) % frames.size();
-      refreshTime += (1.0 / refreshFrequency);
-    }
-
-    ImGui::SetNextWindowPos(ImVec2(5, 5));
-    ImGui::Begin("FPS", nullptr,
-                 ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs |
-                     ImGuiWindowFlags_NoBringToFrontOnFocus |
-                     ImGuiWindowFlags_NoFocusOnAppearing);
-    auto const label{fmt::format("avg {:.1f} FPS", fps)};
-    ImGui::PlotLines("", frames.data(), gsl::narrow<int>(frames.size()),
-                     gsl::narrow<int>(offset), label.c_str(), 0.0f,
-                     *std::ranges::max_element(frames) * 2,
-                     ImVec2(gsl::narrow<float>(frames.size()), 50));
-    ImGui::End();
+    abcg::Window::paintFrameStatisticsUI();
   }
 
   // Fullscreen button
@@ -227,10 +255,46 @@ void abcg::VulkanWindow::onResize() {}
  * This virtual function is called just before abcg::VulkanWindow::onPaint, even
  * if the window is minimized.
  *
+ * If abcg::WindowSettings::pipelinedUpdate is `true`, this is called on a
+ * worker thread and updates the next frame while the current frame is
+ * rendered. In this case, it must not call graphics API functions.
+ *
  * Override it for custom behavior. By default, it does nothing.
  */
 void abcg::VulkanWindow::onUpdate() {}
 
+/**
+ * @brief Custom handler for fixed-timestep updates.
+ *
+ * This virtual function is called zero or more times per frame, just before
+ * abcg::VulkanWindow::onUpdate, when abcg::WindowSettings::fixedDeltaTime is
+ * greater than zero. Use it for simulations that must advance with a constant
+ * time step, such as physics. Use abcg::Window::getInterpolationFactor to
+ * interpolate the simulation state when rendering.
+ *
+ * @param deltaTime Fixed time step, in seconds.
+ *
+ * Override it for custom behavior. By default, it does nothing.
+ */
+void abcg::VulkanWindow::onFixedUpdate([[maybe_unused]] double deltaTime) {}
+
+/**
+ * @brief Custom handler for handing off the updated state to the renderer.
+ *
+ * This virtual function is called on the main thread for each frame, after
+ * abcg::VulkanWindow::onUpdate has finished and before
+ * abcg::VulkanWindow::onPaint.
+ *
+ * If abcg::WindowSettings::pipelinedUpdate is `true`,
+ * abcg::VulkanWindow::onUpdate runs on a worker thread concurrently with the
+ * paint handlers. In this case, keep separate copies of the simulation state
+ * and the render state, and copy or swap them here, where no update is
+ * running.
+ *
+ * Override it for custom behavior. By default, it does nothing.
+ */
+void abcg::VulkanWindow::onHandoff() {}
+
 /**
  * @brief Custom handler for cleaning up Vulkan resources.
  *
@@ -269,15 +333,21 @@ void abcg::VulkanWindow::handleEvent(SDL_Event const &event) {
 }
 
 void abcg::VulkanWindow::create() {
+  if (abcg::Window::getWindowSettings().headless) {
+    throw abcg::RuntimeError("Headless mode is not supported by VulkanWindow");
+  }
+
   // Create window fol Vulkan graphics
   if (!createSDLWindow(SDL_WINDOW_VULKAN)) {
     throw abcg::SDLError("SDL_CreateWindow failed");
   }
+  markStartupPhase("SDL window");
 
   // Create Vulkan instance
   auto const applicationName{abcg::Window::getWindowSettings().title};
   auto const requiredExtensions{getRequiredExtensions(Window::getSDLWindow())};
   m_instance.create(m_layers, requiredExtensions, applicationName);
+  markStartupPhase("Vulkan instance");
 
   // Create window surface
   if (VkSurfaceKHR surface{};
@@ -305,9 +375,11 @@ void abcg::VulkanWindow::create() {
 
   // Create logical device
   m_device.create(m_physicalDevice, m_deviceExtensions);
+  markStartupPhase("Vulkan device");
 
   // Create swapchain
   m_swapchain.create(m_device, m_vulkanSettings, getWindowSize());
+  markStartupPhase("Vulkan swapchain");
 
   // Create descriptor pool
   std::vector<vk::DescriptorPoolSize> const poolSizes{
@@ -330,8 +402,6 @@ void abcg::VulkanWindow::create() {
        .pPoolSizes = poolSizes.data()});
 
   // Setup Dear ImGui context
-  IMGUI_CHECKVERSION();
-  ImGui::CreateContext();
   ImGuiIO &guiIO{ImGui::GetIO()};
   // Enable keyboard controls
   guiIO.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
@@ -394,15 +464,23 @@ void abcg::VulkanWindow::create() {
 
     ImGui_ImplVulkan_DestroyFontUploadObjects();
   }
+  markStartupPhase("Dear ImGui");
 
   onCreate();
+  markStartupPhase("onCreate");
 
   onResize();
 }
 
-void abcg::VulkanWindow::paint() {
-  onUpdate();
+void abcg::VulkanWindow::fixedUpdate(double deltaTime) {
+  onFixedUpdate(deltaTime);
+}
+
+void abcg::VulkanWindow::update() { onUpdate(); }
+
+void abcg::VulkanWindow::handoff() { onHandoff(); }
 
+void abcg::VulkanWindow::paint() {
   if (m_hidden || m_minimized) {
     return;
   }
@@ -414,15 +492,26 @@ void abcg::VulkanWindow::paint() {
   // ImGUI requires at least 2 images in the swapchain
   ImGui_ImplVulkan_SetMinImageCount(2);
 
-  ImGui_ImplVulkan_NewFrame();
-  ImGui_ImplSDL2_NewFrame();
-  ImGui::NewFrame();
+  {
+    ABCG_PROFILE_SCOPE("onPaintUI");
+    ImGui_ImplVulkan_NewFrame();
+    ImGui_ImplSDL2_NewFrame();
+    ImGui::NewFrame();
+
+    onPaintUI();
 
-  onPaintUI();
+    ImGui::Render();
+  }
 
-  ImGui::Render();
+  {
+    ABCG_PROFILE_SCOPE("Record and submit");
+    m_swapchain.render([this](auto const &frame) {
+      ABCG_PROFILE_SCOPE("onPaint");
+      onPaint(frame);
+    });
+  }
 
-  m_swapchain.render([this](auto const &frame) { onPaint(frame); });
+  ABCG_PROFILE_SCOPE("Present");
   m_swapchain.present();
 }
 
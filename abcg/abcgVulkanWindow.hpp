@@ -13,6 +13,9 @@
 #ifndef ABCG_VULKAN_WINDOW_HPP_
 #define ABCG_VULKAN_WINDOW_HPP_
 
+#include <span>
+#include <string_view>
+
 #include "abcgVulkanDevice.hpp"
 #include "abcgVulkanInstance.hpp"
 #include "abcgVulkanPhysicalDevice.hpp"
@@ -57,6 +60,13 @@ struct abcg::VulkanSettings {
    * comes first.
    */
   bool vSync{false};
+
+  /** @brief Whether to measure the GPU time of each frame with timestamp
+   * queries.
+   *
+   * @sa abcg::VulkanWindow::getGPUFrameTime.
+   */
+  bool gpuTimerQueries{true};
 };
 
 /**
@@ -72,9 +82,11 @@ struct abcg::VulkanSettings {
  * @sa abcg::VulkanWindow::onPaintUI for UI rendering.
  * @sa abcg::VulkanWindow::onResize for handling swapchain rebuild events.
  * @sa abcg::VulkanWindow::onUpdate for commands to be called every frame.
+ * @sa abcg::VulkanWindow::onFixedUpdate for fixed-timestep updates.
+ * @sa abcg::VulkanWindow::onHandoff for handing off the updated state.
  * @sa abcg::VulkanWindow::onDestroy for cleaning up Vulkan resources.
  *
- * @remark Objects of this type cannot be copied or copy-constructed.
+ * @remark Objects of this type cannot be copied or moved.
  */
 class abcg::VulkanWindow : public Window {
 public:
@@ -84,20 +96,30 @@ public:
   [[nodiscard]] VulkanPhysicalDevice const &getPhysicalDevice() const noexcept;
   [[nodiscard]] VulkanDevice const &getDevice() const noexcept;
   [[nodiscard]] VulkanSwapchain const &getSwapchain() const noexcept;
+  [[nodiscard]] double getGPUFrameTime() const noexcept final;
+  [[nodiscard]] std::span<GPUPassTime const>
+  getGPUPassTimes() const noexcept final;
 
 protected:
+  void writeGPUTimestamp(VulkanFrame const &frame, std::string_view name);
+
   virtual void onEvent(SDL_Event const &event);
   virtual void onCreate();
   virtual void onPaint(VulkanFrame const &frame);
   virtual void onPaintUI();
   virtual void onResize();
   virtual void onUpdate();
+  virtual void onFixedUpdate(double deltaTime);
+  virtual void onHandoff();
   virtual void onDestroy();
 
 private:
   void handleEvent(SDL_Event const &event) final;
   void create() final;
   void paint() final;
+  void fixedUpdate(double deltaTime) final;
+  void update() final;
+  void handoff() final;
   void destroy() final;
   [[nodiscard]] glm::ivec2 getWindowSize() const final;
 
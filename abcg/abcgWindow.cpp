@@ -14,6 +14,16 @@
 
 #include <imgui_impl_sdl2.h>
 
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "abcgException.hpp"
+#include "abcgProfiler.hpp"
+
 namespace {
 ImVec4 ColorAlpha(ImVec4 const &color, float const alpha) {
   return {color.x, color.y, color.z, alpha};
@@ -155,12 +165,45 @@ abcg::fullscreenchangeCallback(int eventType,
 }
 #endif
 
+// Worker thread used when WindowSettings::pipelinedUpdate is true
+struct abcg::Window::UpdateWorker {
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool pending{};
+  bool quit{};
+  std::exception_ptr exception;
+
+  UpdateWorker() = default;
+  UpdateWorker(UpdateWorker const &) = delete;
+  UpdateWorker(UpdateWorker &&) = delete;
+  UpdateWorker &operator=(UpdateWorker const &) = delete;
+  UpdateWorker &operator=(UpdateWorker &&) = delete;
+  ~UpdateWorker() {
+    {
+      std::scoped_lock const lock{mutex};
+      quit = true;
+    }
+    condition.notify_all();
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+};
+
+/**
+ * @brief Default destructor.
+ */
+abcg::Window::~Window() = default;
+
 /**
  * @brief Returns the time that have passed since the last frame.
  *
- * This delta time has a minimum resolution of 2ms. If the time is smaller than
- * that, zero is returned. Internally, the delta time accumulates for the next
- * frame(s) until at least 2ms have passed.
+ * If abcg::WindowSettings::targetFPS is zero, this delta time has a minimum
+ * resolution of 2ms. If the time is smaller than that, zero is returned.
+ * Internally, the delta time accumulates for the next frame(s) until at least
+ * 2ms have passed. If a target frame rate is set, the actual time between
+ * frames is returned.
  *
  * @returns Time in seconds.
  */
@@ -169,9 +212,53 @@ double abcg::Window::getDeltaTime() const noexcept { return m_lastDeltaTime; }
 /**
  * @brief Returns the time that have passed since the window was created.
  *
+ * When replaying an input trace, this is the sum of the recorded delta times.
+ *
  * @returns Time in seconds.
  */
-double abcg::Window::getElapsedTime() const { return m_elapsedTime.elapsed(); }
+double abcg::Window::getElapsedTime() const {
+  if (m_replayDeltaTime) {
+    return m_replayElapsedTime;
+  }
+  return m_elapsedTime.elapsed();
+}
+
+/**
+ * @brief Returns the fraction of a fixed time step that was not yet simulated.
+ *
+ * Use this factor to interpolate between the previous and the current state
+ * of a simulation updated with a fixed time step, so that rendering is smooth
+ * even when the frame rate is not a multiple of the simulation rate.
+ *
+ * @returns Value in the range [0, 1). Zero if
+ * abcg::WindowSettings::fixedDeltaTime is zero.
+ *
+ * @sa abcg::WindowSettings::fixedDeltaTime
+ */
+double abcg::Window::getInterpolationFactor() const noexcept {
+  auto const fixedDeltaTime{m_windowSettings.fixedDeltaTime};
+  if (fixedDeltaTime <= 0.0) {
+    return 0.0;
+  }
+  return m_fixedTimeAccumulator / fixedDeltaTime;
+}
+
+/**
+ * @brief Returns the job system of the application.
+ *
+ * Use the job system to run CPU work in parallel, for instance, in
+ * abcg::OpenGLWindow::onCreate or abcg::OpenGLWindow::onUpdate.
+ *
+ * @returns Reference to the job system owned by abcg::Application.
+ *
+ * @throw abcg::RuntimeError if called when the application is not running.
+ */
+abcg::JobSystem &abcg::Window::getJobSystem() const {
+  if (m_jobSystem == nullptr) {
+    throw abcg::RuntimeError("Job system is not available");
+  }
+  return *m_jobSystem;
+}
 
 /**
  * @brief Returns the current configuration settings of the window.
@@ -209,6 +296,38 @@ void abcg::Window::setWindowSettings(WindowSettings const &windowSettings) {
   m_windowSettings = windowSettings;
 }
 
+/**
+ * @brief Requests the window to be repainted in the next iteration of the main
+ * loop.
+ *
+ * This is only needed when abcg::WindowSettings::renderOnDemand is `true`.
+ * Call this function, for instance, in abcg::OpenGLWindow::onUpdate to keep
+ * repainting while an animation is running.
+ *
+ * @remark This can be called from the main thread or from the update handler,
+ * which runs on a worker thread if abcg::WindowSettings::pipelinedUpdate is
+ * `true`.
+ */
+void abcg::Window::requestRepaint() noexcept {
+  // Request a single repaint unless more are already pending
+  auto noPendingRepaints{0};
+  m_pendingRepaints.compare_exchange_strong(noPendingRepaints, 1);
+}
+
+/**
+ * @brief Returns the timing statistics of the frames painted by this window.
+ *
+ * The CPU time and the present interval of each frame are measured on the
+ * main thread. The GPU time is measured with the timer queries of the graphics
+ * API, if enabled and supported.
+ *
+ * @returns Reference to the frame statistics of the window.
+ */
+abcg::FrameStatistics const &
+abcg::Window::getFrameStatistics() const noexcept {
+  return *m_frameStatistics;
+}
+
 /**
  * @brief Returns the SDL window previously created with
  * abcg::Window::createOpenGLWindow or abcg::Window::createVulkanWindow.
@@ -233,7 +352,8 @@ Uint32 abcg::Window::getSDLWindowID() const noexcept { return m_windowID; }
  * @brief Creates the SDL window.
  *
  * @param extraFlags Extra SDL window flags to be combined with the common
- * flags (`SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI`).
+ * flags (`SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI`, and
+ * `SDL_WINDOW_HIDDEN` if abcg::WindowSettings::headless is `true`).
  *
  * @returns `true` on success; `false` on failure.
  */
@@ -242,12 +362,16 @@ bool abcg::Window::createSDLWindow(SDL_WindowFlags extraFlags) {
     return false;
   }
 
-  auto commonFlags{SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI};
+  auto commonFlags{gsl::narrow<Uint32>(SDL_WINDOW_RESIZABLE |
+                                       SDL_WINDOW_ALLOW_HIGHDPI)};
+  if (m_windowSettings.headless) {
+    commonFlags |= gsl::narrow<Uint32>(SDL_WINDOW_HIDDEN);
+  }
 
   m_window = SDL_CreateWindow(
       m_windowSettings.title.c_str(), SDL_WINDOWPOS_CENTERED,
       SDL_WINDOWPOS_CENTERED, m_windowSettings.width, m_windowSettings.height,
-      gsl::narrow<Uint32>(extraFlags) | gsl::narrow<Uint32>(commonFlags));
+      gsl::narrow<Uint32>(extraFlags) | commonFlags);
   if (m_window == nullptr) {
     return false;
   }
@@ -279,6 +403,77 @@ void abcg::Window::setEnableResizingEventWatcher(bool enabled) noexcept {
   m_enableResizingEventWatcher = enabled;
 }
 
+/**
+ * @brief Marks the end of a phase of the window creation.
+ *
+ * The duration of the phase is the time elapsed since the previous call to
+ * this function, or since the window creation started.
+ *
+ * @param name Name of the phase.
+ *
+ * @sa abcg::Application::getStartupPhases
+ */
+void abcg::Window::markStartupPhase(std::string_view name) {
+  m_startupPhases.push_back(
+      {.name = std::string{name}, .duration = m_startupTimer.restart()});
+}
+
+/**
+ * @brief Shows a Dear ImGui window with the frame rate and the frame time
+ * statistics.
+ *
+ * The window shows a plot of the interval between recent frames, the
+ * percentiles of the frame interval over the last
+ * abcg::FrameStatistics::windowSize frames, the number of hitches, and the GPU
+ * time of the frame and of its passes, if available.
+ *
+ * This is called by the default implementations of
+ * abcg::OpenGLWindow::onPaintUI and abcg::VulkanWindow::onPaintUI when
+ * abcg::WindowSettings::showFPS is `true`.
+ */
+void abcg::Window::paintFrameStatisticsUI() {
+  auto const plotSize{ImVec2(150, 50)};
+  auto const samples{m_frameStatistics->getRecentSamples(
+      gsl::narrow<std::size_t>(plotSize.x))};
+  auto const summary{m_frameStatistics->getSummary()};
+
+  std::vector<float> intervals;
+  intervals.reserve(samples.size());
+  for (auto const &sample : samples) {
+    intervals.push_back(gsl::narrow_cast<float>(sample.presentInterval));
+  }
+
+  ImGui::SetNextWindowPos(ImVec2(5, 5));
+  ImGui::Begin("FPS", nullptr,
+               ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs |
+                   ImGuiWindowFlags_NoBringToFrontOnFocus |
+                   ImGuiWindowFlags_NoFocusOnAppearing |
+                   ImGuiWindowFlags_AlwaysAutoResize);
+  auto const label{fmt::format("avg {:.1f} FPS", ImGui::GetIO().Framerate)};
+  ImGui::PlotLines("", intervals.data(), gsl::narrow<int>(intervals.size()), 0,
+                   label.c_str(), 0.0f,
+                   gsl::narrow_cast<float>(summary.presentInterval.max) * 1.5f,
+                   plotSize);
+
+  auto const &interval{summary.presentInterval};
+  ImGui::TextUnformatted(fmt::format("p50 {:.2f} p95 {:.2f} p99 {:.2f} ms",
+                                     interval.p50, interval.p95, interval.p99)
+                             .c_str());
+  ImGui::TextUnformatted(fmt::format("max {:.2f} ms, {} hitches", interval.max,
+                                     m_frameStatistics->getHitchCount())
+                             .c_str());
+
+  if (auto const gpuFrameTime{getGPUFrameTime()}; gpuFrameTime > 0.0) {
+    ImGui::TextUnformatted(fmt::format("GPU {:.3f} ms", gpuFrameTime).c_str());
+    for (auto const &pass : getGPUPassTimes()) {
+      ImGui::TextUnformatted(
+          fmt::format("  {}: {:.3f} ms", pass.name, pass.milliseconds)
+              .c_str());
+    }
+  }
+  ImGui::End();
+}
+
 /**
  * @brief Toggles between fullscreen and windowed mode.
  */
@@ -320,8 +515,16 @@ void abcg::Window::toggleFullscreen() {
 }
 
 void abcg::Window::templateHandleEvent(SDL_Event const &event, bool &done) {
+  // Event handlers must not run concurrently with the update handler
+  waitForUpdate();
+
+  ImGui::SetCurrentContext(m_imGuiContext);
   ImGui_ImplSDL2_ProcessEvent(&event);
 
+  // Dear ImGui may need an extra frame to settle after processing an input
+  // event (e.g., to update hovered widgets)
+  m_pendingRepaints = 2;
+
   if (event.window.windowID != m_windowID) {
     return;
   }
@@ -387,24 +590,134 @@ void abcg::Window::templateHandleEvent(SDL_Event const &event, bool &done) {
 }
 
 void abcg::Window::templateCreate() {
+  m_startupPhases.clear();
+  m_startupTimer.restart();
+
   m_deltaTime.restart();
   m_elapsedTime.restart();
 
+  m_frameStatistics->clear();
+  m_frameStatistics->setKeepHistory(
+      !m_windowSettings.frameStatisticsFilename.empty());
+
+  // Each window has its own Dear ImGui context
+  IMGUI_CHECKVERSION();
+  m_imGuiContext = ImGui::CreateContext();
+  ImGui::SetCurrentContext(m_imGuiContext);
+
   create();
 
   // Set up our own Dear ImGui style
   setupImGuiStyle(true, 1.0f);
+  markStartupPhase("Dear ImGui style");
+
+  m_presentTimer.restart();
+
+#if !defined(__EMSCRIPTEN__)
+  if (m_windowSettings.pipelinedUpdate) {
+    m_updateWorker = std::make_unique<UpdateWorker>();
+    m_updateWorker->thread = std::thread([this] {
+      Profiler::setThreadName(
+          fmt::format("Update thread (window {})", getSDLWindowID()));
+      auto &worker{*m_updateWorker};
+      while (true) {
+        {
+          std::unique_lock lock{worker.mutex};
+          worker.condition.wait(
+              lock, [&worker] { return worker.pending || worker.quit; });
+          if (!worker.pending) {
+            return;
+          }
+        }
+        try {
+          ABCG_PROFILE_SCOPE("onUpdate");
+          update();
+        } catch (...) {
+          worker.exception = std::current_exception();
+        }
+        {
+          std::scoped_lock const lock{worker.mutex};
+          worker.pending = false;
+        }
+        worker.condition.notify_all();
+      }
+    });
+  }
+#endif
 }
 
 void abcg::Window::templatePaint() {
-  // Cap to 480 Hz
-  if (m_deltaTime.elapsed() >= 1.0 / 480.0) {
+  ABCG_PROFILE_SCOPE("Frame");
+  Timer const cpuTime;
+
+  {
+    ABCG_PROFILE_SCOPE("Wait for update");
+    waitForUpdate();
+  }
+
+  ImGui::SetCurrentContext(m_imGuiContext);
+
+  if (m_pendingRepaints.load() > 0) {
+    // The update handler is not running, so no repaint is requested
+    // concurrently
+    m_pendingRepaints.fetch_sub(1);
+  }
+
+  if (m_replayDeltaTime) {
+    // Use the delta time recorded in the input trace
+    m_lastDeltaTime = *m_replayDeltaTime;
+    m_replayElapsedTime += m_lastDeltaTime;
+  } else if (m_windowSettings.targetFPS > 0.0) {
+    // Frames are already paced by waitForNextFrame
+    m_lastDeltaTime = m_deltaTime.restart();
+  } else if (m_deltaTime.elapsed() >= 1.0 / 480.0) {
+    // Cap to 480 Hz
     m_lastDeltaTime = m_deltaTime.restart();
   } else {
     m_lastDeltaTime = 0.0;
   }
 
+  if (auto const fixedDeltaTime{m_windowSettings.fixedDeltaTime};
+      fixedDeltaTime > 0.0) {
+    m_fixedTimeAccumulator += m_lastDeltaTime;
+    auto steps{0};
+    while (m_fixedTimeAccumulator >= fixedDeltaTime &&
+           steps < m_windowSettings.maxFixedSteps) {
+      ABCG_PROFILE_SCOPE("onFixedUpdate");
+      fixedUpdate(fixedDeltaTime);
+      m_fixedTimeAccumulator -= fixedDeltaTime;
+      ++steps;
+    }
+    // Discard the whole time steps we could not catch up with, but keep the
+    // fractional part for interpolation
+    m_fixedTimeAccumulator = std::fmod(m_fixedTimeAccumulator, fixedDeltaTime);
+  }
+
+  if (m_updateWorker) {
+    // Render this frame with the state updated during the previous frame,
+    // while the next frame is updated in the worker thread
+    {
+      ABCG_PROFILE_SCOPE("onHandoff");
+      handoff();
+    }
+    launchUpdate();
+  } else {
+    {
+      ABCG_PROFILE_SCOPE("onUpdate");
+      update();
+    }
+    ABCG_PROFILE_SCOPE("onHandoff");
+    handoff();
+  }
+
   paint();
+
+  ++m_frameCount;
+
+  m_frameStatistics->record(
+      {.cpuTime = cpuTime.elapsed() * 1000.0,
+       .presentInterval = m_presentTimer.restart() * 1000.0,
+       .gpuTime = getGPUFrameTime()});
 }
 
 void abcg::Window::templateDestroy() {
@@ -412,9 +725,87 @@ void abcg::Window::templateDestroy() {
     return;
   }
 
+  if (m_updateWorker) {
+    {
+      std::unique_lock lock{m_updateWorker->mutex};
+      m_updateWorker->condition.wait(
+          lock, [this] { return !m_updateWorker->pending; });
+    }
+    m_updateWorker.reset();
+  }
+
+  ImGui::SetCurrentContext(m_imGuiContext);
   destroy();
+  m_imGuiContext = nullptr;
+
+  if (auto const &filename{m_windowSettings.frameStatisticsFilename};
+      !filename.empty()) {
+    m_frameStatistics->writeFile(filename);
+  }
 
   SDL_DestroyWindow(m_window);
   m_window = nullptr;
   m_windowID = 0;
-}
\ No newline at end of file
+}
+
+void abcg::Window::waitForNextFrame() {
+  using clock = std::chrono::steady_clock;
+
+  if (m_windowSettings.targetFPS <= 0.0) {
+    return;
+  }
+
+  auto const framePeriod{std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<double>(1.0 / m_windowSettings.targetFPS))};
+
+  // Schedule from the previous deadline instead of from the current time so
+  // that oversleeping does not accumulate
+  m_nextFrameTime += framePeriod;
+
+  auto const now{clock::now()};
+  if (now >= m_nextFrameTime) {
+    // Running late. Resynchronize if more than one frame behind
+    if (now - m_nextFrameTime > framePeriod) {
+      m_nextFrameTime = now;
+    }
+    return;
+  }
+
+  // Sleep until shortly before the deadline, as the OS may wake us up late
+  if (auto const spinTime{std::chrono::milliseconds(2)};
+      m_nextFrameTime - now > spinTime) {
+    std::this_thread::sleep_until(m_nextFrameTime - spinTime);
+  }
+
+  // Spin-wait for the remaining time
+  while (clock::now() < m_nextFrameTime) {
+    std::this_thread::yield();
+  }
+}
+
+bool abcg::Window::needsRepaint() const noexcept {
+  return !m_windowSettings.renderOnDemand || m_pendingRepaints > 0;
+}
+
+void abcg::Window::launchUpdate() {
+  {
+    std::scoped_lock const lock{m_updateWorker->mutex};
+    m_updateWorker->pending = true;
+  }
+  m_updateWorker->condition.notify_all();
+}
+
+void abcg::Window::waitForUpdate() {
+  if (!m_updateWorker) {
+    return;
+  }
+
+  std::unique_lock lock{m_updateWorker->mutex};
+  m_updateWorker->condition.wait(lock,
+                                 [this] { return !m_updateWorker->pending; });
+
+  // Propagate exceptions thrown by the update handler
+  if (auto exception{std::exchange(m_updateWorker->exception, nullptr)}) {
+    std::rethrow_exception(exception);
+  }
+}
@@ -13,9 +13,20 @@
 #ifndef ABCG_WINDOW_HPP_
 #define ABCG_WINDOW_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "abcgApplication.hpp"
 #include "abcgExternal.hpp"
+#include "abcgFrameStatistics.hpp"
+#include "abcgGPUTimer.hpp"
+#include "abcgJobSystem.hpp"
 #include "abcgTimer.hpp"
 
 #if defined(__EMSCRIPTEN__)
@@ -68,6 +79,111 @@ struct abcg::WindowSettings {
   std::string fullscreenElementID{"#canvas"};
   /** @brief String containing the window title. */
   std::string title{"ABCg Window"};
+  /** @brief Whether to run the application without a visible window.
+   *
+   * If `true`, the SDL window is created hidden and the SDL offscreen video
+   * driver is requested before SDL is initialized. With OpenGL windows, the
+   * offscreen driver renders to an EGL pbuffer surface, which allows running
+   * on render nodes and CI machines without a display (e.g., with Mesa's
+   * llvmpipe). The driver can still be overridden by setting the
+   * `SDL_VIDEODRIVER` environment variable.
+   *
+   * @remark This must be set before calling abcg::Application::run. Headless
+   * mode is not supported in WebAssembly builds or by abcg::VulkanWindow.
+   */
+  bool headless{false};
+  /** @brief Number of frames to render before the application exits.
+   *
+   * If zero, the application runs until the window is closed. Otherwise, the
+   * main loop ends after rendering this number of frames and the average frame
+   * time is printed to the standard output.
+   *
+   * @remark Not supported in WebAssembly builds.
+   */
+  std::size_t maxFrames{0};
+  /** @brief Target frame rate, in frames per second.
+   *
+   * If greater than zero, the main loop is paced to this frame rate: the
+   * application sleeps until shortly before the next frame is due and then
+   * spin-waits for the remaining time. Frame deadlines are scheduled from the
+   * previous deadline, so oversleeping in one frame does not accumulate drift.
+   * If zero, the main loop runs as fast as possible (or as allowed by vertical
+   * synchronization).
+   *
+   * @remark In WebAssembly builds, this is used as the frame rate of the
+   * browser main loop and must be set before calling abcg::Application::run.
+   */
+  double targetFPS{0.0};
+  /** @brief Whether to repaint the window only when needed.
+   *
+   * If `true`, the window is repainted only after processing an event or
+   * after a call to abcg::Window::requestRepaint. When there is nothing to
+   * repaint, the main loop blocks waiting for new events instead of
+   * continuously rendering new frames. This is useful for static scenes, as it
+   * reduces CPU and GPU usage to near zero when the application is idle.
+   *
+   * Animated scenes can call abcg::Window::requestRepaint for each frame
+   * while the animation is running.
+   */
+  bool renderOnDemand{false};
+  /** @brief Time step of the fixed-timestep update, in seconds.
+   *
+   * If greater than zero, the fixed update handler (e.g.,
+   * abcg::OpenGLWindow::onFixedUpdate) is called zero or more times per frame
+   * with this constant time step, so that the simulated time keeps up with the
+   * real time regardless of the frame rate. The fraction of a time step that
+   * was not yet simulated is available through
+   * abcg::Window::getInterpolationFactor. If zero, the fixed update handler is
+   * never called.
+   */
+  double fixedDeltaTime{0.0};
+  /** @brief Maximum number of fixed updates per frame.
+   *
+   * If the simulation falls behind by more than this number of time steps
+   * (e.g., because a frame took too long to render), the remaining time is
+   * discarded. This prevents the simulation from spending more and more time
+   * catching up at each frame.
+   */
+  int maxFixedSteps{5};
+  /** @brief Whether to update the next frame while the current frame is
+   * rendered.
+   *
+   * If `true`, the update handler (e.g., abcg::OpenGLWindow::onUpdate) runs on
+   * a worker thread and computes frame N+1 while the main thread renders frame
+   * N. The state produced by the update handler must be explicitly handed off
+   * to the renderer in the handoff handler (e.g.,
+   * abcg::OpenGLWindow::onHandoff), which is called on the main thread while
+   * no update is running. The update handler must not call graphics API
+   * functions and must not access data used by the paint handlers without
+   * synchronization.
+   *
+   * @remark This must be set before calling abcg::Application::run. Ignored in
+   * WebAssembly builds.
+   */
+  bool pipelinedUpdate{false};
+  /** @brief Whether to merge consecutive mouse motion and mouse wheel events.
+   *
+   * If `true`, consecutive `SDL_MOUSEMOTION` events targeted to this window
+   * and received in the same iteration of the main loop are merged into a
+   * single event with the latest position and timestamp, and with the sum of
+   * the relative motions. Consecutive `SDL_MOUSEWHEEL` events are merged
+   * likewise, with the sum of the scrolled amounts. Events are merged only if
+   * they are not interleaved with other events, so the order of button and
+   * keyboard events relative to motion events is preserved.
+   *
+   * This reduces the event handling cost when using mice with high polling
+   * rates.
+   */
+  bool coalesceInputEvents{false};
+  /** @brief Path of a file to write the timing of each frame to.
+   *
+   * If not empty, the timing of all frames is kept and written to this file
+   * when the window is destroyed. The file is written in JSON format if the
+   * path ends with `.json`, or in CSV format otherwise.
+   *
+   * @sa abcg::FrameStatistics::writeFile.
+   */
+  std::string frameStatisticsFilename{};
 };
 
 /**
@@ -81,7 +197,7 @@ struct abcg::WindowSettings {
  * @sa abcg::Window::paint for frame rendering commands.
  * @sa abcg::Window::destroy for window termination.
  *
- * @remark Objects of this type cannot be copied or copy-constructed.
+ * @remark Objects of this type cannot be copied or moved.
  */
 class abcg::Window {
 public:
@@ -90,22 +206,15 @@ public:
    */
   Window() = default;
   Window(Window const &) = delete;
-  /**
-   * @brief Default move constructor.
-   */
-  Window(Window &&) = default;
+  Window(Window &&) = delete;
   Window &operator=(Window const &) = delete;
-  /**
-   * @brief Default move assignment.
-   */
-  Window &operator=(Window &&) = default;
-  /**
-   * @brief Default destructor.
-   */
-  virtual ~Window() = default;
+  Window &operator=(Window &&) = delete;
+  virtual ~Window();
 
   [[nodiscard]] WindowSettings const &getWindowSettings() const noexcept;
   void setWindowSettings(WindowSettings const &windowSettings);
+  void requestRepaint() noexcept;
+  [[nodiscard]] FrameStatistics const &getFrameStatistics() const noexcept;
 
 protected:
   /**
@@ -134,6 +243,33 @@ protected:
    */
   virtual void paint() = 0;
 
+  /**
+   * @brief Custom handler for fixed-timestep updates.
+   *
+   * This is called zero or more times per frame, before painting, when
+   * abcg::WindowSettings::fixedDeltaTime is greater than zero.
+   *
+   * @param deltaTime Fixed time step, in seconds.
+   */
+  virtual void fixedUpdate(double deltaTime) = 0;
+
+  /**
+   * @brief Custom handler for frame updates.
+   *
+   * This is called once per frame, before painting. If
+   * abcg::WindowSettings::pipelinedUpdate is `true`, this is called on a worker
+   * thread, concurrently with abcg::Window::paint.
+   */
+  virtual void update() = 0;
+
+  /**
+   * @brief Custom handler for handing off the updated state to the renderer.
+   *
+   * This is called once per frame on the main thread, after the update of the
+   * frame has finished and before painting.
+   */
+  virtual void handoff() = 0;
+
   /**
    * @brief Custom handler for window cleanup tasks.
    *
@@ -152,12 +288,32 @@ protected:
    */
   [[nodiscard]] virtual glm::ivec2 getWindowSize() const = 0;
 
+  /**
+   * @brief Returns the GPU time of a recent frame.
+   *
+   * @returns GPU time, in milliseconds, or zero if not available.
+   */
+  [[nodiscard]] virtual double getGPUFrameTime() const noexcept = 0;
+
+  /**
+   * @brief Returns the GPU time of the passes of a recent frame.
+   *
+   * @returns GPU time of each pass of the frame whose time is returned by
+   * abcg::Window::getGPUFrameTime.
+   */
+  [[nodiscard]] virtual std::span<GPUPassTime const>
+  getGPUPassTimes() const noexcept = 0;
+
   [[nodiscard]] double getDeltaTime() const noexcept;
   [[nodiscard]] double getElapsedTime() const;
+  [[nodiscard]] double getInterpolationFactor() const noexcept;
+  [[nodiscard]] JobSystem &getJobSystem() const;
   [[nodiscard]] SDL_Window *getSDLWindow() const noexcept;
   [[nodiscard]] Uint32 getSDLWindowID() const noexcept;
 
   bool createSDLWindow(SDL_WindowFlags extraFlags);
+  void markStartupPhase(std::string_view name);
+  void paintFrameStatisticsUI();
   void setEnableResizingEventWatcher(bool enabled) noexcept;
   void toggleFullscreen();
 
@@ -166,6 +322,12 @@ private:
   void templateCreate();
   void templatePaint();
   void templateDestroy();
+  void waitForNextFrame();
+  [[nodiscard]] bool needsRepaint() const noexcept;
+  void launchUpdate();
+  void waitForUpdate();
+
+  struct UpdateWorker;
 
   SDL_Window *m_window{};
   Uint32 m_windowID{};
@@ -175,6 +337,22 @@ private:
   Timer m_deltaTime;
   Timer m_elapsedTime;
   double m_lastDeltaTime{};
+  std::size_t m_frameCount{};
+  std::chrono::steady_clock::time_point m_nextFrameTime;
+  // Written by abcg::Window::requestRepaint, which may run on the update
+  // thread
+  std::atomic<int> m_pendingRepaints{1};
+  double m_fixedTimeAccumulator{};
+  std::unique_ptr<UpdateWorker> m_updateWorker;
+  JobSystem *m_jobSystem{};
+  ImGuiContext *m_imGuiContext{};
+  std::optional<double> m_replayDeltaTime;
+  Timer m_startupTimer;
+  std::vector<StartupPhase> m_startupPhases;
+  double m_replayElapsedTime{};
+  std::unique_ptr<FrameStatistics> m_frameStatistics{
+      std::make_unique<FrameStatistics>()};
+  Timer m_presentTimer;
 
   bool m_enableResizingEventWatcher{true};
 
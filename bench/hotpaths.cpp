@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "abcg.hpp"
+#include "abcgImage.hpp"
+#include "abcgShader.hpp"
+#if defined(ABCG_BENCH_VULKAN)
+#include "abcgVulkanShader.hpp"
+#endif
+
+namespace {
+struct Result {
+  std::string name;
+  int runs{};
+  double medianMs{};
+  double minMs{};
+  double maxMs{};
+};
+
+// Keeps the compiler from optimizing away the results of benchmarked code
+std::size_t sink{};
+
+// Measures several runs of a function after a warm-up run
+Result measure(std::string_view name, std::function<void()> const &function,
+               int runs = 15) {
+  std::vector<double> times;
+  function(); // Warm-up
+  for ([[maybe_unused]] auto const run : iter::range(runs)) {
+    abcg::Timer timer;
+    function();
+    times.push_back(timer.elapsed() * 1000.0);
+  }
+  std::ranges::sort(times);
+  Result result{.name = std::string{name},
+                .runs = runs,
+                .medianMs = times.at(times.size() / 2),
+                .minMs = times.front(),
+                .maxMs = times.back()};
+  fmt::print("{:<44} {:>10.3f} ms (min {:.3f}, max {:.3f})\n", result.name,
+             result.medianMs, result.minMs, result.maxMs);
+  return result;
+}
+
+void benchFlip(std::vector<Result> &results) {
+  constexpr auto size{2048};
+  for (auto const &[label, format] :
+       {std::pair{"RGB", SDL_PIXELFORMAT_RGB24},
+        std::pair{"RGBA", SDL_PIXELFORMAT_RGBA32}}) {
+    auto *surface{SDL_CreateRGBSurfaceWithFormat(0, size, size, 0, format)};
+    if (surface == nullptr) {
+      throw abcg::SDLError("SDL_CreateRGBSurfaceWithFormat failed");
+    }
+    auto const freeSurface{
+        gsl::finally([surface] { SDL_FreeSurface(surface); })};
+
+    results.push_back(
+        measure(fmt::format("flipVertically {0}x{0} {1}", size, label),
+                [surface] { abcg::flipVertically(*surface); }));
+    results.push_back(
+        measure(fmt::format("flipHorizontally {0}x{0} {1}", size, label),
+                [surface] { abcg::flipHorizontally(*surface); }));
+  }
+}
+
+void benchHashCombine(std::vector<Result> &results) {
+  constexpr auto numHashes{1'000'000};
+  std::string const text{"Some text"};
+  results.push_back(
+      measure(fmt::format("hashCombine x{}", numHashes), [&text] {
+        for (auto const index : iter::range(numHashes)) {
+          sink += abcg::hashCombine(index, 3.14f * static_cast<float>(index),
+                                    text);
+        }
+      }));
+}
+
+void benchTrackBall(std::vector<Result> &results) {
+  constexpr auto numMoves{100'000};
+  constexpr glm::ivec2 viewportSize{1280, 720};
+  abcg::TrackBall trackBall;
+  trackBall.resizeViewport(viewportSize);
+
+  results.push_back(
+      measure(fmt::format("TrackBall mouseMove+getRotation x{}", numMoves),
+              [&trackBall, viewportSize] {
+                trackBall.mousePress(viewportSize / 2);
+                for (auto const index : iter::range(numMoves)) {
+                  trackBall.mouseMove(
+                      {index % viewportSize.x, (index / 7) % viewportSize.y});
+                  sink += static_cast<std::size_t>(
+                      trackBall.getRotation().w > 0.0f);
+                }
+                trackBall.mouseRelease(viewportSize / 2);
+              }));
+}
+
+std::string makeShaderSource() {
+  std::string source{"#version 450\n\n"
+                     "layout(location = 0) in vec3 inPosition;\n"
+                     "layout(location = 1) in vec3 inNormal;\n"
+                     "layout(location = 0) out vec4 outColor;\n\n"
+                     "void main() {\n"
+                     "  vec3 color = vec3(0.0);\n"};
+  for (auto const index : iter::range(256)) {
+    source += fmt::format("  color += sin(inNormal * {0}.0 + inPosition) / "
+                          "{1}.0; // Term {0}\n",
+                          index, index + 1);
+  }
+  source += "  gl_Position = vec4(inPosition, 1.0);\n"
+            "  outColor = vec4(color, 1.0);\n"
+            "}\n";
+  return source;
+}
+
+void benchShaders(std::vector<Result> &results) {
+  auto const source{makeShaderSource()};
+  auto const path{std::filesystem::temp_directory_path() /
+                  "abcg_bench_shader.vert"};
+  std::ofstream(path) << source;
+  auto const removeFile{gsl::finally([&path] {
+    std::error_code errorCode;
+    std::filesystem::remove(path, errorCode);
+  })};
+
+  constexpr auto numReads{200};
+  results.push_back(measure(
+      fmt::format("readShaderSource {} KiB file x{}", source.size() / 1024,
+                  numReads),
+      [pathString = path.string()] {
+        for ([[maybe_unused]] auto const read : iter::range(numReads)) {
+          sink += abcg::readShaderSource(pathString).size();
+        }
+      }));
+
+#if defined(ABCG_BENCH_VULKAN)
+  results.push_back(measure(
+      "compileShaderToSPIRV vertex shader",
+      [&source] {
+        sink += abcg::compileShaderToSPIRV(
+                    {.source = source, .stage = abcg::ShaderStage::Vertex})
+                    .size();
+      },
+      5));
+#endif
+}
+
+std::string makeOBJ(int gridSize) {
+  std::ostringstream obj;
+  for (auto const row : iter::range(gridSize)) {
+    for (auto const column : iter::range(gridSize)) {
+      obj << fmt::format("v {} 0 {}\nvn 0 1 0\nvt {} {}\n", column, row,
+                         column / static_cast<float>(gridSize),
+                         row / static_cast<float>(gridSize));
+    }
+  }
+  for (auto const row : iter::range(gridSize - 1)) {
+    for (auto const column : iter::range(gridSize - 1)) {
+      auto const first{row * gridSize + column + 1};
+      auto const second{first + gridSize};
+      obj << fmt::format("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n",
+                         first, second, second + 1, first + 1);
+    }
+  }
+  return obj.str();
+}
+
+void benchOBJ(std::vector<Result> &results) {
+  constexpr auto gridSize{256};
+  auto const obj{makeOBJ(gridSize)};
+  results.push_back(measure(
+      fmt::format("tinyobj::LoadObj {0}x{0} grid ({1} KiB)", gridSize,
+                  obj.size() / 1024),
+      [&obj] {
+        std::istringstream stream{obj};
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warning;
+        std::string error;
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warning, &error,
+                              &stream)) {
+          throw abcg::RuntimeError(fmt::format("Failed to parse OBJ: {}",
+                                               error));
+        }
+        sink += attrib.vertices.size() + shapes.size();
+      },
+      5));
+}
+
+void writeJSON(std::string const &filename,
+               std::vector<Result> const &results) {
+  std::ofstream stream(filename);
+  if (!stream) {
+    throw abcg::RuntimeError(
+        fmt::format("Failed to create results file {}", filename));
+  }
+  stream << fmt::format(R"({{"version":"{}.{}.{}","benchmarks":[)",
+                        ABCG_VERSION_MAJOR, ABCG_VERSION_MINOR,
+                        ABCG_VERSION_PATCH);
+  for (auto const &&[index, result] : iter::enumerate(results)) {
+    stream << fmt::format(
+        R"({}{{"name":"{}","runs":{},"medianMs":{:.6f},"minMs":{:.6f},)"
+        R"("maxMs":{:.6f}}})",
+        index == 0 ? "\n" : ",\n", result.name, result.runs, result.medianMs,
+        result.minMs, result.maxMs);
+  }
+  stream << "]}\n";
+}
+} // namespace
+
+// Usage: abcg_bench [results.json]
+int main(int argc, char **argv) {
+  try {
+    std::vector<Result> results;
+    benchFlip(results);
+    benchHashCombine(results);
+    benchTrackBall(results);
+    benchShaders(results);
+    benchOBJ(results);
+
+    if (argc > 1) {
+      std::span const args{argv, gsl::narrow<std::size_t>(argc)};
+      writeJSON(args[1], results);
+      fmt::print("\nResults written to {}\n", args[1]);
+    }
+    fmt::print("\nChecksum: {}\n", sink);
+  } catch (std::exception const &exception) {
+    fmt::print(stderr, "{}", exception.what());
+    return -1;
+  }
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <span>
+#include <vector>
+
+#include "abcg.hpp"
+
+namespace {
+// Returns the median time, in milliseconds, of several runs of a function
+double measure(std::function<void()> const &function, int runs = 15) {
+  std::vector<double> times;
+  function(); // Warm-up
+  for ([[maybe_unused]] auto const run : iter::range(runs)) {
+    abcg::Timer timer;
+    function();
+    times.push_back(timer.elapsed() * 1000.0);
+  }
+  std::ranges::sort(times);
+  return times.at(times.size() / 2);
+}
+
+void heavyWork(float &value) {
+  for ([[maybe_unused]] auto const i : iter::range(16)) {
+    value = std::sin(value) * 0.5f + std::sqrt(std::abs(value) + 1.0f);
+  }
+}
+
+void printResult(std::string_view name, double ms, double baselineMs) {
+  fmt::print("{:<36} {:>10.3f} ms {:>8.2f}x\n", name, ms, baselineMs / ms);
+}
+} // namespace
+
+int main() {
+  try {
+    abcg::JobSystem jobSystem;
+    auto const numThreads{jobSystem.getWorkerCount() + 1};
+    fmt::print("Job system with {} worker threads\n\n", numThreads - 1);
+
+    // parallelFor over a large span
+    {
+      std::vector<float> data(1 << 18);
+      std::span const span{data};
+      auto const batchSize{std::max<std::size_t>(
+          1, data.size() / (4 * numThreads))};
+
+      auto const serialMs{measure([&] {
+        std::ranges::for_each(data, heavyWork);
+      })};
+
+      auto const asyncMs{measure([&] {
+        std::vector<std::future<void>> futures;
+        for (std::size_t first{}; first < span.size(); first += batchSize) {
+          auto const batch{span.subspan(
+              first, std::min(batchSize, span.size() - first))};
+          futures.push_back(std::async(std::launch::async, [batch] {
+            std::ranges::for_each(batch, heavyWork);
+          }));
+        }
+        for (auto &future : futures) {
+          future.get();
+        }
+      })};
+
+      auto const jobSystemMs{measure([&] {
+        jobSystem.parallelFor(span, heavyWork, batchSize);
+      })};
+
+      fmt::print("parallelFor ({} elements, batches of {})\n", data.size(),
+                 batchSize);
+      printResult("  serial", serialMs, serialMs);
+      printResult("  std::async", asyncMs, serialMs);
+      printResult("  abcg::JobSystem::parallelFor", jobSystemMs, serialMs);
+    }
+
+    // Many small jobs
+    {
+      auto const numJobs{10'000};
+      std::vector<float> data(gsl::narrow<std::size_t>(numJobs));
+
+      auto const asyncMs{measure([&] {
+        std::vector<std::future<void>> futures;
+        futures.reserve(data.size());
+        for (auto &value : data) {
+          futures.push_back(std::async(std::launch::async,
+                                       [&value] { heavyWork(value); }));
+        }
+        for (auto &future : futures) {
+          future.get();
+        }
+      })};
+
+      auto const jobSystemMs{measure([&] {
+        abcg::JobCounter counter;
+        for (auto &value : data) {
+          jobSystem.run([&value] { heavyWork(value); }, counter);
+        }
+        jobSystem.wait(counter);
+      })};
+
+      fmt::print("\nSmall jobs ({} jobs)\n", numJobs);
+      printResult("  std::async", asyncMs, asyncMs);
+      printResult("  abcg::JobSystem::run", jobSystemMs, asyncMs);
+    }
+  } catch (std::exception const &exception) {
+    fmt::print(stderr, "{}", exception.what());
+    return -1;
+  }
+  return 0;
+}
@@ -8,6 +8,17 @@ set(GRAPHICS_API
     CACHE STRING "Choose the graphics API.")
 set_property(CACHE GRAPHICS_API PROPERTY STRINGS "OpenGL" "Vulkan" "None")
 
+# OpenGL call counters
+option(ENABLE_GL_CALL_COUNTERS "Count calls of the OpenGL function wrappers"
+       OFF)
+
+# Cache of OpenGL bindings for skipping redundant binds
+option(ENABLE_GL_STATE_CACHE "Skip redundant binds in the OpenGL wrappers" OFF)
+
+# Sampled OpenGL error checks in release builds
+option(ENABLE_GL_SAMPLED_ERROR_CHECKS
+       "Check OpenGL errors every few calls in release builds" OFF)
+
 if(NOT ${CMAKE_SYSTEM_NAME} MATCHES "Emscripten")
   # Conan
   option(ENABLE_CONAN "Use Conan Package Manager" OFF)
@@ -22,6 +33,9 @@ if(NOT ${CMAKE_SYSTEM_NAME} MATCHES "Emscripten")
     option(ENABLE_IPO "Enable Interprocedural Optimization" ON)
   endif()
 
+  # Benchmarks
+  option(ENABLE_BENCHMARKS "Build benchmarks" OFF)
+
   set(OPTIONS_TARGET options)
   set(SANITIZERS_TARGET sanitizers)
   set(WARNINGS_TARGET warnings)